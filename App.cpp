@@ -0,0 +1,317 @@
+#include "App.h"
+
+#include <cstring>
+#include <iostream>
+
+// --- GEOMETRIJA ---
+
+float floorHeightPx(const App& app) { return app.height / (float)app.sim.floorCount; }
+
+float liftVisualX(const App& app) {
+    float buildingWidth = app.width * 0.3f;
+    float buildingX = app.width - buildingWidth;
+    return buildingX + (buildingWidth * 0.1f);
+}
+
+float liftY(const App& app, int car) {
+    return (float)carPositionAt(app.sim.cars[car], app.sim.time) * floorHeightPx(app);
+}
+
+Car& panelCar(App& app) { return app.sim.cars[app.personInLift ? app.personCar : 0]; }
+
+std::string floorName(int i) {
+    if (i == 0) return "SU";
+    if (i == 1) return "PR";
+    return std::to_string(i - 1);
+}
+
+// --- RASPORED DUGMADI ---
+static void layoutButtons(App& app) {
+    app.buttons.clear();
+    app.layoutVersion++;
+    app.panelWidth = app.width * 0.35f;
+
+    float panelCenterX = app.panelWidth / 2.0f;
+    float startY = app.height * 0.8f;
+    float btnW = app.panelWidth * 0.3f;
+    float btnH = app.height * 0.06f;
+    float gapX = btnW * 0.2f;
+    float gapY = btnH * 0.5f;
+
+    const int floorCount = app.sim.floorCount;
+    if ((int)app.floorNames.size() != floorCount) {
+        app.floorNames.clear();
+        for (int i = 0; i < floorCount; i++) app.floorNames.push_back(floorName(i));
+    }
+
+    // --- SPRATOVI ---
+    // Dva dugmeta po redu, od najviseg sprata nadole; preko 8 spratova
+    // dugmad se smanjuju da bi stala iznad specijalnih tastera
+    int rows = (floorCount + 1) / 2;
+    float floorBtnH = (rows > 4) ? btnH * 4.0f / rows : btnH;
+    float floorGapY = floorBtnH * 0.5f;
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < 2; col++) {
+            int logicIndex = floorCount - 1 - (row * 2 + col);
+            if (logicIndex < 0) break;
+            Button b;
+            if (col == 0) b.x = panelCenterX - btnW - (gapX / 2);
+            else          b.x = panelCenterX + (gapX / 2);
+            b.y = startY - row * (floorBtnH + floorGapY);
+            b.w = btnW; b.h = floorBtnH;
+            b.label = app.floorNames[logicIndex];
+            b.isPressed = panelCar(app).carCalls.test(logicIndex);
+            b.floorIndex = logicIndex;
+            b.actionType = 0;
+            app.buttons.push_back(b);
+        }
+    }
+
+    // --- SPECIJALNI TASTERI ---
+    float specStartY = app.height * 0.3f;
+    std::string specs[] = { "OTVORI", "ZATVORI", "STOP", "VENT" };
+    for (int i = 0; i < 4; i++) {
+        Button b;
+        if (i % 2 == 0) b.x = panelCenterX - btnW - (gapX / 2);
+        else            b.x = panelCenterX + (gapX / 2);
+        b.y = specStartY - (i / 2) * (btnH + gapY);
+        b.w = btnW; b.h = btnH;
+        b.label = specs[i];
+        b.isPressed = false;
+        b.floorIndex = -1;
+        b.actionType = i + 1;
+        app.buttons.push_back(b);
+    }
+
+    app.maxDoorHeight = floorHeightPx(app) * 0.9f;
+}
+
+void initApp(App& app, uint64_t seed, int floorCount, int carCount) {
+    app = App();
+    app.seed = seed;
+    initSimulation(app.sim, floorCount, carCount, 2);
+}
+
+void resizeApp(App& app, float width, float height) {
+    if (width <= 0.0f || height <= 0.0f) return;
+
+    bool firstRun = (app.width <= 0.0f || app.height <= 0.0f);
+    if (!firstRun) {
+        app.personY *= height / app.height;
+        app.personX *= width / app.width;
+    }
+    app.width = width;
+    app.height = height;
+
+    if (firstRun) {
+        // Osoba krece sa prizemlja, tacno od leve ivice zgrade (30% sirine s desna)
+        app.personY = 1 * floorHeightPx(app);
+        app.personX = app.width - app.width * 0.3f;
+        app.personInLift = false;
+    }
+
+    app.panelWidth = app.width * 0.35f;
+    if (app.personX < app.panelWidth) app.personX = app.panelWidth + 10;
+    layoutButtons(app);
+}
+
+// --- INPUTS (Tastatura) ---
+void keyApp(App& app, int key, int action, int mods) {
+    Simulation& sim = app.sim;
+
+    // T: ukljucuje/iskljucuje generisani saobracaj (mesavina ulaza, izlaza i voznji izmedju spratova)
+    if (key == APP_KEY_T && action == APP_PRESS) {
+        if (sim.traffic.mix.rate > 0.0) stopTraffic(sim);
+        else startTraffic(sim, trafficMix(TRAFFIC_LUNCH, GUI_TRAFFIC_RATE), app.seed + (uint64_t)app.ticks);
+        if (app.echo) std::cout << "Saobracaj: " << (sim.traffic.mix.rate > 0.0 ? "UKLJUCEN" : "ISKLJUCEN") << std::endl;
+        return;
+    }
+
+    // P: sledeca politika dispecera (SCAN, LOOK, najbliza kabina, ETA)
+    if (key == APP_KEY_P && action == APP_PRESS) {
+        sim.policy = (DispatchPolicy)((sim.policy + 1) % DISPATCH_POLICY_COUNT);
+        if (app.echo) std::cout << "Dispecer: " << policyName(sim.policy) << std::endl;
+        return;
+    }
+
+    // + / -: brze ili sporije vreme (menja samo koliko koraka ide u sekundi)
+    if ((key == APP_KEY_EQUAL || key == APP_KEY_MINUS) && action == APP_PRESS) {
+        int scale = app.timeScale + (key == APP_KEY_EQUAL ? 1 : -1);
+        if (scale >= 0 && scale < TIME_SCALE_COUNT) app.timeScale = scale;
+        if (app.echo) std::cout << "Brzina vremena: " << stepsPerTick(app) << "x" << std::endl;
+        return;
+    }
+
+    if (action != APP_PRESS && action != APP_REPEAT) return;
+    float moveSpeed = 10.0f;
+
+    // 1. OSOBA JE VAN LIFTA
+    if (!app.personInLift) {
+        if (key == APP_KEY_A) { // Levo
+            app.personX -= moveSpeed;
+
+            // Ne dozvoljavamo da ode levo od pocetka zgrade
+            float buildingStart = app.width - (app.width * 0.3f);
+            if (app.personX < buildingStart) app.personX = buildingStart;
+        }
+        if (key == APP_KEY_W) { // Desno
+            app.personX += moveSpeed;
+
+            // === LOGIKA ULAZKA U LIFT (W) ===
+            // Ako predjemo prag lifta DOK su vrata neke kabine otvorena na nasem spratu
+            if (app.personX >= liftVisualX(app)) {
+                int personFloor = (int)(app.personY / floorHeightPx(app));
+                int car = carWithOpenDoor(sim, personFloor);
+                if (car >= 0 && sim.cars[car].liftState == DOOR_OPEN) {
+                    app.personInLift = true; // <--- OSOBA ULAZI
+                    app.personCar = car;
+                    if (app.echo) std::cout << "Usao u lift " << car << "!" << std::endl;
+                }
+            }
+
+            // Granica je 92% sirine ekrana
+            if (app.personX > app.width * 0.92f) app.personX = app.width * 0.92f;
+        }
+
+        // === LOGIKA POZIVANJA LIFTA (C = GORE, SHIFT + C = DOLE) ===
+        if (key == APP_KEY_C && app.personX >= (app.width * 0.92f)) {
+            int personFloor = (int)(app.personY / floorHeightPx(app));
+            int dir = (mods & APP_MOD_SHIFT) ? CALL_DOWN : CALL_UP;
+            if (app.echo) std::cout << "Pozivam lift na sprat: " << personFloor
+                                    << (dir == CALL_UP ? " (GORE)" : " (DOLE)") << std::endl;
+
+            // Ako je neka kabina vec tu i otvorena u nasem smeru, koristi W za ulaz
+            if (carWithOpenDoor(sim, personFloor, dir) < 0) {
+                int car = hallCall(sim, personFloor, dir);
+                if (app.echo) std::cout << "Dolazi kabina: " << car << " (za oko "
+                                        << (int)(hallCallEta(sim, personFloor, dir) + 0.5) << " s)" << std::endl;
+            }
+        }
+    }
+
+    // 2. OSOBA JE U LIFTU
+    else {
+        if (key == APP_KEY_A) {
+            // === LOGIKA IZLASKA IZ LIFTA (A) ===
+            // Izlazak moguc samo ako su vrata otvorena
+            const Car& car = sim.cars[app.personCar];
+            if (car.liftState == DOOR_OPEN) {
+                app.personInLift = false; // <--- OSOBA IZLAZI
+
+                // Izbaci osobu ispred lifta, na visinu trenutnog sprata
+                app.personX = liftVisualX(app) - 30.0f;
+                app.personY = car.currentFloor * floorHeightPx(app);
+                if (app.echo) std::cout << "Izasao iz lifta na spratu: " << car.currentFloor << std::endl;
+            }
+        }
+        // W i C ne rade nista dok si u liftu (vozis se)
+    }
+}
+
+// --- INPUTS (Mis) ---
+void clickApp(App& app, int button, int action, float x, float y) {
+    if (button != APP_MOUSE_LEFT || action != APP_PRESS) return;
+    if (!app.personInLift) return;
+
+    float clickX = x;
+    float clickY = app.height - y;
+    for (Button& b : app.buttons) {
+        if (clickX < b.x || clickX > b.x + b.w || clickY < b.y || clickY > b.y + b.h) continue;
+
+        if (b.actionType == 0) { // SPRAT
+            b.isPressed = true;
+            carCall(app.sim, app.personCar, b.floorIndex);
+        }
+        else if (b.actionType == 1) { // OTVORI
+            if (extendDoor(app.sim, app.personCar) && app.echo) {
+                std::cout << "Vrata produzena!" << std::endl;
+            }
+        }
+        else if (b.actionType == 2) { // ZATVORI
+            closeDoor(app.sim, app.personCar);
+        }
+        else if (b.actionType == 3) { // STOP
+            emergencyStop(app.sim, app.personCar);
+            for (Button& bb : app.buttons) bb.isPressed = false;
+        }
+        else if (b.actionType == 4) { // VENTILACIJA
+            toggleVentilation(app.sim.cars[app.personCar]);
+        }
+    }
+}
+
+int stepsPerTick(const App& app) { return TIME_SCALES[app.timeScale]; }
+
+void stepApp(App& app) {
+    stepSimulation(app.sim);
+    app.ticks++;
+
+    // Ako je osoba u liftu, njena Y koordinata je uvek fiksirana za kabinu
+    if (app.personInLift) {
+        app.personY = liftY(app, app.personCar) + 5; // +5 da ne propadne kroz pod
+    }
+}
+
+// --- OTISAK STANJA ---
+// FNV-1a preko bajtova svakog polja (double i float bit po bit), pa i
+// najmanja razlika u racunu menja otisak
+struct Fnv {
+    uint64_t h = 0xCBF29CE484222325ull;
+
+    void bytes(const void* data, size_t size) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++) { h ^= p[i]; h *= 0x100000001B3ull; }
+    }
+    template <class T> void add(const T& value) { bytes(&value, sizeof(value)); }
+    void add(const RequestSet& set) { bytes(set.data(), set.wordCount() * sizeof(uint64_t)); }
+};
+
+uint64_t hashApp(const App& app) {
+    const Simulation& sim = app.sim;
+    Fnv f;
+    f.add(app.ticks);
+    f.add(sim.time);
+    f.add(sim.eventsProcessed);
+    f.add((int)sim.policy);
+    for (const Car& car : sim.cars) {
+        f.add(car.position);
+        f.add(car.currentFloor);
+        f.add(car.nextFloor);
+        f.add((int)car.liftState);
+        f.add(car.lastDirection);
+        f.add(car.door);
+        f.add(car.doorOpenTimeStart);
+        f.add(car.extendedOnce);
+        f.add(car.ventilationOn);
+        f.add(car.stateTime);
+        f.add(car.eventTime);
+        f.add(car.version);
+        f.add(car.carCalls);
+        f.add(car.hallUp);
+        f.add(car.hallDown);
+        f.add(car.load);
+    }
+    f.add(sim.hallUp);
+    f.add(sim.hallDown);
+    for (int floor = 0; floor < sim.floorCount; floor++) {
+        f.add(sim.upAssignment[floor]);
+        f.add(sim.downAssignment[floor]);
+        f.add(sim.waitingUp[floor].size());
+        f.add(sim.waitingDown[floor].size());
+    }
+    for (const PassengerGroup& riders : sim.riders) f.add(riders.size());
+    f.add(sim.traffic.rng.state);
+    f.add(sim.traffic.nextArrival);
+    f.add(sim.metrics.passengers);
+    f.add(sim.metrics.delivered);
+    f.add(sim.metrics.hallCalls);
+    f.add(sim.metrics.carCalls);
+
+    f.add(app.width);
+    f.add(app.height);
+    f.add(app.personX);
+    f.add(app.personY);
+    f.add(app.personInLift);
+    f.add(app.personCar);
+    return f.h;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Simulation.h"
+
+// --- STANJE PROZORA BEZ OPENGL-A ---
+// Sve sto tastatura, mis i promena velicine prozora menjaju: osoba,
+// raspored dugmadi i simulacija. Prozor (Main.cpp) samo prosledjuje ulaz
+// ovim funkcijama i crta stanje, pa isti ulaz bez prozora (LiftSim --replay)
+// prolazi kroz isti kod i daje isto stanje.
+//
+// Vreme je broj koraka (tick), a ne sat masine: korak je uvek SIM_DT, a ulaz
+// se primenjuje izmedju koraka. Jedino sto zavisi od realnog vremena je
+// koliko koraka nit simulacije napravi u sekundi, a to se belezi uz ulaz (InputLog.h).
+
+// Tasteri i dugmad misa, iste vrednosti kao u GLFW-u (slova su ASCII)
+const int APP_KEY_A = 'A';
+const int APP_KEY_C = 'C';
+const int APP_KEY_P = 'P';
+const int APP_KEY_T = 'T';
+const int APP_KEY_W = 'W';
+const int APP_KEY_MINUS = '-';
+const int APP_KEY_EQUAL = '=';      // Taster sa "+" na vecini tastatura
+const int APP_MOD_SHIFT = 0x0001;
+const int APP_RELEASE = 0;
+const int APP_PRESS = 1;
+const int APP_REPEAT = 2;
+const int APP_MOUSE_LEFT = 0;
+
+const int GUI_CAR_COUNT = 3;            // Broj kabina (okana) u prikazu
+const double GUI_TRAFFIC_RATE = 120.0;  // Putnika na sat kad je saobracaj ukljucen (T)
+
+// Ubrzanje vremena (+ / -): koliko koraka od SIM_DT nit simulacije napravi za
+// jedan SIM_DT realnog vremena. Vrata, stajanje i ventilator idu po
+// simulacionom satu, pa se svi ubrzavaju zajedno.
+const int TIME_SCALES[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+const int TIME_SCALE_COUNT = sizeof(TIME_SCALES) / sizeof(TIME_SCALES[0]);
+
+struct Button {
+    float x, y, w, h;
+    std::string label;
+    bool isPressed;
+    int floorIndex;
+    int actionType; // 0=sprat, 1=otv, 2=zat, 3=stop, 4=vent
+};
+
+struct App {
+    Simulation sim;
+    uint64_t seed = 0;              // Iz njega se izvodi seed saobracaja (T)
+    long long ticks = 0;            // Broj koraka od SIM_DT od pocetka
+    bool echo = true;               // Ispis poruka na std::cout
+    int timeScale = 0;              // Indeks u TIME_SCALES
+
+    float width = 0.0f;             // Velicina prozora (px)
+    float height = 0.0f;
+    float panelWidth = 0.0f;
+    float maxDoorHeight = 0.0f;
+    std::vector<std::string> floorNames; // SU, PR, 1, 2, ...
+    std::vector<Button> buttons;
+    unsigned int layoutVersion = 0; // Raste svaki put kad se dugmad ponovo rasporede
+
+    // Osoba
+    float personX = 0.0f;
+    float personY = 0.0f;
+    bool personInLift = false;
+    int personCar = 0;              // Kabina u kojoj je osoba (panel upravlja njome)
+};
+
+void initApp(App& app, uint64_t seed, int floorCount = DEFAULT_FLOOR_COUNT, int carCount = GUI_CAR_COUNT);
+
+// Nova velicina prozora: osoba se skalira, dugmad se ponovo rasporedjuju
+void resizeApp(App& app, float width, float height);
+
+// Tastatura (APP_KEY_*, APP_PRESS...) i mis; x, y su koordinate kursora
+// kao u GLFW-u (y raste nadole)
+void keyApp(App& app, int key, int action, int mods);
+void clickApp(App& app, int button, int action, float x, float y);
+
+// Koraka po SIM_DT realnog vremena (TIME_SCALES[app.timeScale])
+int stepsPerTick(const App& app);
+
+// Jedan korak od SIM_DT; osoba u liftu se vozi sa kabinom
+void stepApp(App& app);
+
+// Otisak stanja (FNV-1a) za poredjenje snimka i ponovljenog izvodjenja
+uint64_t hashApp(const App& app);
+
+// --- GEOMETRIJA (deli je crtanje u Main.cpp) ---
+float floorHeightPx(const App& app);
+float liftVisualX(const App& app);          // Gde lift vizuelno pocinje (za ulazak)
+float liftY(const App& app, int car);
+Car& panelCar(App& app);                    // Kabina ciji panel vidimo: ona u kojoj je osoba
+std::string floorName(int i);               // 0 = SU, 1 = PR, ostali redom od 1
@@ -0,0 +1,212 @@
+#include "BatchEnv.h"
+#include "Simulation.h"
+#include "Traffic.h"
+
+#include <bit>
+#include <cmath>
+
+// Seed zgrade i za svaku epizodu: isti config daje iste epizode bez obzira na K
+static uint64_t instanceSeed(uint64_t seed, int index, uint32_t episode) {
+    Rng mix;
+    mix.state = seed ^ ((uint64_t)index * 0xD1B54A32D192ED03ull) ^ ((uint64_t)episode << 40);
+    return mix.next();
+}
+
+static void resetInstance(BatchEnv& env, int i) {
+    env.position[i] = 0.0f;
+    env.door[i] = 0.0f;
+    env.timer[i] = 0.0f;
+    env.state[i] = IDLE;
+    env.direction[i] = 0;
+    env.floor[i] = 0;
+    env.carCalls[i] = 0;
+    env.hallUp[i] = 0;
+    env.hallDown[i] = 0;
+    env.rng[i] = instanceSeed(env.config.seed, i, env.episode[i]);
+    env.steps[i] = 0;
+}
+
+static void writeObservations(BatchEnv& env) {
+    const int K = env.config.instances;
+    const int F = env.config.floors;
+    const float top = (float)(F - 1);
+    for (int i = 0; i < K; i++) {
+        float* o = &env.obs[(size_t)i * env.obsSize];
+        o[0] = env.position[i] / top;
+        o[1] = env.door[i];
+        o[2] = (float)env.state[i] / (float)DOOR_CLOSING;
+        o[3] = (float)env.direction[i];
+        uint64_t car = env.carCalls[i], up = env.hallUp[i], down = env.hallDown[i];
+        for (int f = 0; f < F; f++) {
+            o[4 + f] = (float)((car >> f) & 1);
+            o[4 + F + f] = (float)((up >> f) & 1);
+            o[4 + 2 * F + f] = (float)((down >> f) & 1);
+        }
+    }
+}
+
+void initBatch(BatchEnv& env, const BatchConfig& config) {
+    env = BatchEnv();
+    env.config = config;
+    if (env.config.instances < 1) env.config.instances = 1;
+    if (env.config.floors < 2) env.config.floors = 2;
+    if (env.config.floors > BatchEnv::MAX_FLOORS) env.config.floors = BatchEnv::MAX_FLOORS;
+    if (env.config.ticksPerStep < 1) env.config.ticksPerStep = 1;
+
+    const size_t K = (size_t)env.config.instances;
+    env.obsSize = 4 + 3 * env.config.floors;
+    env.position.resize(K);
+    env.door.resize(K);
+    env.timer.resize(K);
+    env.state.resize(K);
+    env.direction.resize(K);
+    env.floor.resize(K);
+    env.carCalls.resize(K);
+    env.hallUp.resize(K);
+    env.hallDown.resize(K);
+    env.rng.resize(K);
+    env.steps.resize(K);
+    env.episode.assign(K, 0);
+    env.obs.resize(K * env.obsSize);
+    env.reward.resize(K);
+    env.done.resize(K);
+
+    // Voznja jedan sprat je uvek ista, pa se profil racuna jednom, po tick-u
+    Trip trip = planTrip(env.config.motion, env.config.motion.floorHeight);
+    env.tripTime = (float)trip.totalTime;
+    int ticks = (int)std::ceil(trip.totalTime / SIM_DT);
+    env.tripProfile.resize(ticks + 1);
+    for (int k = 0; k <= ticks; k++) {
+        env.tripProfile[k] = (float)(tripDistanceAt(trip, k * SIM_DT) / env.config.motion.floorHeight);
+    }
+
+    double p = env.config.arrivalRate * SIM_DT / 3600.0;
+    if (p > 1.0) p = 1.0;
+    env.arrivalThreshold = (p >= 1.0) ? ~0ull : (uint64_t)(p * 18446744073709551616.0);
+
+    resetBatch(env);
+}
+
+void resetBatch(BatchEnv& env) {
+    for (int i = 0; i < env.config.instances; i++) resetInstance(env, i);
+    for (int i = 0; i < env.config.instances; i++) { env.reward[i] = 0.0f; env.done[i] = 0; }
+    writeObservations(env);
+}
+
+void stepBatch(BatchEnv& env, const uint8_t* actions) {
+    const int K = env.config.instances;
+    const int F = env.config.floors;
+    const float dt = (float)SIM_DT;
+    const int lastTick = (int)env.tripProfile.size() - 1;
+
+    // --- 1. AKCIJE: samo kabine koje stoje zatvorene ---
+    for (int i = 0; i < K; i++) {
+        if (env.state[i] != IDLE) continue;
+        switch (actions[i]) {
+        case BATCH_UP:
+            if (env.floor[i] < F - 1) { env.state[i] = MOVING_UP; env.direction[i] = 1; env.timer[i] = 0.0f; }
+            break;
+        case BATCH_DOWN:
+            if (env.floor[i] > 0) { env.state[i] = MOVING_DOWN; env.direction[i] = -1; env.timer[i] = 0.0f; }
+            break;
+        case BATCH_OPEN:
+            env.state[i] = DOOR_OPENING;
+            env.timer[i] = 0.0f;
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (int i = 0; i < K; i++) env.reward[i] = 0.0f;
+
+    for (int tick = 0; tick < env.config.ticksPerStep; tick++) {
+        // --- 2. DOLASCI PUTNIKA: poziv sa sprata u smeru odredista ---
+        for (int i = 0; i < K; i++) {
+            Rng r;
+            r.state = env.rng[i];
+            if (r.next() < env.arrivalThreshold) {
+                int origin = r.below(F);
+                int destination = r.below(F - 1);
+                if (destination >= origin) destination++;
+                if (destination > origin) env.hallUp[i] |= 1ull << origin;
+                else env.hallDown[i] |= 1ull << origin;
+            }
+            env.rng[i] = r.state;
+        }
+
+        // --- 3. AUTOMAT STANJA ---
+        for (int i = 0; i < K; i++) env.timer[i] += dt;
+
+        for (int i = 0; i < K; i++) {
+            float timer = env.timer[i];
+            switch (env.state[i]) {
+            case MOVING_UP:
+            case MOVING_DOWN: {
+                int k = (int)(timer / dt + 0.5f);
+                if (k >= lastTick) {
+                    env.floor[i] = (int16_t)(env.floor[i] + env.direction[i]);
+                    env.position[i] = env.floor[i];
+                    env.state[i] = IDLE;
+                }
+                else {
+                    env.position[i] = env.floor[i] + env.direction[i] * env.tripProfile[k];
+                }
+                break;
+            }
+            case DOOR_OPENING:
+                if (timer >= DOOR_MOVE_TIME) {
+                    env.state[i] = DOOR_OPEN;
+                    env.timer[i] = 0.0f;
+                    env.door[i] = 1.0f;
+
+                    // Izlaze oni kojima je ovo odrediste, ulaze svi koji cekaju
+                    int f = env.floor[i];
+                    uint64_t bit = 1ull << f;
+                    env.carCalls[i] &= ~bit;
+                    Rng r;
+                    r.state = env.rng[i];
+                    if (env.hallUp[i] & bit) {
+                        env.hallUp[i] &= ~bit;
+                        env.carCalls[i] |= 1ull << (f + 1 + r.below(F - 1 - f));
+                    }
+                    if (env.hallDown[i] & bit) {
+                        env.hallDown[i] &= ~bit;
+                        env.carCalls[i] |= 1ull << r.below(f);
+                    }
+                    env.rng[i] = r.state;
+                }
+                else {
+                    env.door[i] = timer / (float)DOOR_MOVE_TIME;
+                }
+                break;
+            case DOOR_OPEN:
+                if (timer >= env.config.doorDuration) { env.state[i] = DOOR_CLOSING; env.timer[i] = 0.0f; }
+                break;
+            case DOOR_CLOSING:
+                if (timer >= DOOR_MOVE_TIME) { env.state[i] = IDLE; env.door[i] = 0.0f; }
+                else env.door[i] = 1.0f - timer / (float)DOOR_MOVE_TIME;
+                break;
+            default:
+                break;
+            }
+        }
+
+        // --- 4. NAGRADA: minus sekunde cekanja svih otvorenih poziva ---
+        for (int i = 0; i < K; i++) {
+            int pending = std::popcount(env.carCalls[i]) + std::popcount(env.hallUp[i]) + std::popcount(env.hallDown[i]);
+            env.reward[i] -= pending * dt;
+        }
+    }
+
+    // --- 5. KRAJ EPIZODE ---
+    for (int i = 0; i < K; i++) {
+        env.done[i] = (++env.steps[i] >= env.config.episodeSteps) ? 1 : 0;
+        if (env.done[i]) {
+            env.episode[i]++;
+            resetInstance(env, i);
+        }
+    }
+
+    writeObservations(env);
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Car.h"
+#include "Kinematics.h"
+
+// --- GRUPA OKRUZENJA ZA UCENJE DISPECERA ---
+// K nezavisnih zgrada sa po jednom kabinom, korak za svih K jednim pozivom.
+// Stanje je rasporedjeno po nizovima (structure of arrays): pozicija
+// svih kabina je jedan niz, LiftState svih kabina drugi, pozivi treci...
+// pa svaka faza koraka prolazi kroz uzastopnu memoriju.
+//
+// Kabina je isti automat stanja kao u Car.h (IDLE, voznja, vrata se otvaraju,
+// otvorena, zatvaraju), sa fiksnim korakom SIM_DT kao u prozoru, ali bez
+// reda dogadjaja: odluku donosi akcija, i to samo dok kabina stoji zatvorena.
+// Jedna voznja je uvek jedan sprat, po profilu iz Kinematics.h.
+//
+// Pozivi su bitovi u jednoj 64-bitnoj reci po zgradi (najvise 64 sprata).
+// Putnik ne postoji kao objekat: poziv sa sprata pri ulasku postaje poziv
+// iz kabine na slucajan sprat u smeru poziva.
+
+enum BatchAction : uint8_t {
+    BATCH_WAIT,         // Ostani (ili nastavi ono sto je zapoceto)
+    BATCH_UP,           // Jedan sprat gore
+    BATCH_DOWN,         // Jedan sprat dole
+    BATCH_OPEN          // Otvori vrata na ovom spratu
+};
+
+struct BatchConfig {
+    int instances = 1024;
+    int floors = 8;                         // 2..64
+    int ticksPerStep = 1;                   // Koliko SIM_DT koraka traje jedna akcija
+    double arrivalRate = 120.0;             // Putnika na sat po zgradi
+    int episodeSteps = 3600;                // Posle toliko koraka zgrada se resetuje
+    uint64_t seed = 1;
+    MotionProfile motion;
+    double doorDuration = DOOR_DURATION;
+};
+
+struct BatchEnv {
+    static const int MAX_FLOORS = 64;
+
+    BatchConfig config;
+    int obsSize = 0;                        // Broj float-ova opservacije po zgradi
+
+    // Stanje, po jedan element za svaku zgradu
+    std::vector<float> position;            // U spratovima
+    std::vector<float> door;                // 0 = zatvorena, 1 = otvorena
+    std::vector<float> timer;               // Vreme u trenutnom stanju (s)
+    std::vector<uint8_t> state;             // LiftState
+    std::vector<int8_t> direction;          // Smer voznje u toku
+    std::vector<int16_t> floor;             // Poslednji sprat
+    std::vector<uint64_t> carCalls;
+    std::vector<uint64_t> hallUp;
+    std::vector<uint64_t> hallDown;
+    std::vector<uint64_t> rng;              // SplitMix64 stanje
+    std::vector<int32_t> steps;             // Koraci u tekucoj epizodi
+    std::vector<uint32_t> episode;          // Redni broj epizode (za seed posle reseta)
+
+    // Izlaz koraka; pozivalac cita direktno iz ovih nizova
+    std::vector<float> obs;                 // instances * obsSize
+    std::vector<float> reward;              // instances
+    std::vector<uint8_t> done;              // instances (1 = epizoda je upravo zavrsena i zgrada resetovana)
+
+    // Izvedeno iz config-a pri init-u
+    float tripTime = 0.0f;                  // Trajanje voznje jedan sprat (s)
+    std::vector<float> tripProfile;         // Predjeni deo sprata po tick-u voznje
+    uint64_t arrivalThreshold = 0;          // Verovatnoca dolaska u jednom tick-u, kao prag za 64-bitni broj
+};
+
+void initBatch(BatchEnv& env, const BatchConfig& config);
+
+// Vraca sve zgrade na pocetak (i upisuje opservacije)
+void resetBatch(BatchEnv& env);
+
+// Jedan korak svih zgrada; actions ima config.instances elemenata (BatchAction)
+void stepBatch(BatchEnv& env, const uint8_t* actions);
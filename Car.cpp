@@ -0,0 +1,322 @@
+#include "Car.h"
+#include "Dispatch.h"
+
+#include <cmath>
+#include <limits>
+
+const double NO_EVENT = std::numeric_limits<double>::infinity();
+
+void initCar(Car& car, int floorCount, int startFloor) {
+    car = Car();
+    car.carCalls.resize(floorCount);
+    car.hallUp.resize(floorCount);
+    car.hallDown.resize(floorCount);
+    car.currentFloor = startFloor;
+    car.nextFloor = startFloor;
+    car.position = startFloor;
+    car.eventTime = NO_EVENT;
+}
+
+double carPositionAt(const Car& car, double t) {
+    double travelled = tripDistanceAt(car.trip, t - car.stateTime) / car.motion.floorHeight;
+    if (car.liftState == MOVING_UP) return car.position + travelled;
+    if (car.liftState == MOVING_DOWN) return car.position - travelled;
+    return car.position;
+}
+
+double carDoorAt(const Car& car, double t) {
+    if (car.liftState == DOOR_OPENING) return std::fmin(1.0, car.door + (t - car.stateTime) / DOOR_MOVE_TIME);
+    if (car.liftState == DOOR_CLOSING) return std::fmax(0.0, car.door - (t - car.stateTime) / DOOR_MOVE_TIME);
+    return car.door;
+}
+
+// Racuna sledeci dogadjaj za trenutno stanje; stari plan postaje zastareo
+static void planEvent(Car& car) {
+    switch (car.liftState) {
+    case MOVING_UP:
+    case MOVING_DOWN:
+        car.eventTime = car.stateTime + car.trip.totalTime;
+        break;
+    case DOOR_OPENING: car.eventTime = car.stateTime + (1.0 - car.door) * DOOR_MOVE_TIME; break;
+    case DOOR_OPEN:    car.eventTime = car.doorOpenTimeStart + car.doorDuration; break;
+    case DOOR_CLOSING: car.eventTime = car.stateTime + car.door * DOOR_MOVE_TIME; break;
+    default:           car.eventTime = NO_EVENT; break;
+    }
+    car.version++;
+}
+
+// Zamrzava poziciju i vrata u trenutku t kao novu polaznu tacku
+static void freezeAt(Car& car, double t) {
+    car.position = carPositionAt(car, t);
+    car.door = carDoorAt(car, t);
+    car.stateTime = t;
+}
+
+// Prelazak u stanje bez voznje u trenutku t
+static void setState(Car& car, double t, LiftState state) {
+    freezeAt(car, t);
+    car.liftState = state;
+    planEvent(car);
+}
+
+// Prvi ceo sprat ispred pozicije pos u smeru dir (i iz sredine okna posle STOP-a)
+static int firstFloorAhead(double pos, int dir) {
+    return (dir == 1) ? (int)std::floor(pos + 1e-9) + 1 : (int)std::ceil(pos - 1e-9) - 1;
+}
+
+bool hasCallAt(const Car& car, int f) {
+    return car.carCalls.test(f) || car.hallUp.test(f) || car.hallDown.test(f);
+}
+
+static int minFloor(int a, int b) {
+    if (a < 0) return b;
+    if (b < 0) return a;
+    return a < b ? a : b;
+}
+
+static int maxFloor(int a, int b) { return a > b ? a : b; }
+
+// Puna kabina (bypassesHallCalls) ne staje na pozive sa spratova, pa je ni
+// ne vode: stanice su joj samo pozivi iz kabine
+int nextStopAbove(const Car& car, int f) {
+    int carStop = car.carCalls.nextAbove(f);
+    if (bypassesHallCalls(car)) return carStop;
+    return minFloor(carStop, minFloor(car.hallUp.nextAbove(f), car.hallDown.nextAbove(f)));
+}
+
+int nextStopBelow(const Car& car, int f) {
+    int carStop = car.carCalls.nextBelow(f);
+    if (bypassesHallCalls(car)) return carStop;
+    return maxFloor(carStop, maxFloor(car.hallUp.nextBelow(f), car.hallDown.nextBelow(f)));
+}
+
+bool hasAnyCall(const Car& car) {
+    if (bypassesHallCalls(car)) return car.carCalls.any();
+    return car.carCalls.any() || car.hallUp.any() || car.hallDown.any();
+}
+
+bool bypassesHallCalls(const Car& car) {
+    return car.load > BYPASS_LOAD * car.capacity;
+}
+
+// Kolektivna kontrola: da li kabina koja ide u smeru dir staje na spratu f
+template <class Policy>
+static bool shouldStopHere(const Car& car, int f, int dir) {
+    if (car.carCalls.test(f)) return true;
+    if (bypassesHallCalls(car)) return false; // Puna kabina prolazi pored spratova
+    const RequestSet& same = (dir == 1) ? car.hallUp : car.hallDown;
+    const RequestSet& opposite = (dir == 1) ? car.hallDown : car.hallUp;
+    if (same.test(f)) return true;
+    // Poziv u suprotnom smeru uzimamo samo na mestu okretanja
+    return opposite.test(f) && !Policy::keepsGoing(car, f, dir);
+}
+
+// Brise pozive koje je ova stanica ispunila: iz kabine i sa sprata u najavljenom smeru
+static void clearAnsweredCalls(Car& car) {
+    int f = car.currentFloor;
+    car.carCalls.reset(f);
+    if (car.lastDirection == 1) car.hallUp.reset(f);
+    else car.hallDown.reset(f);
+}
+
+// Gde se zavrsava voznja u smeru dir koja krece ka spratu first: prva
+// stanica, ili mesto gde politika okrece, ili kraj okna
+template <class Policy>
+static int tripTarget(const Car& car, int first, int dir) {
+    int last = (dir == 1) ? car.carCalls.size() - 1 : 0;
+    int f = first;
+    while (true) {
+        if (f == last || shouldStopHere<Policy>(car, f, dir) || !Policy::keepsGoing(car, f, dir)) return f;
+        // Izmedju poziva nema razloga za stajanje, preskacemo do sledeceg
+        int next = (dir == 1) ? nextStopAbove(car, f) : nextStopBelow(car, f);
+        f = (next < 0) ? last : next;
+    }
+}
+
+// Polazak iz mirovanja u trenutku t ka sledecoj stanici u smeru dir
+template <class Policy>
+static void startTrip(Car& car, double t, int dir) {
+    freezeAt(car, t);
+    car.liftState = (dir == 1) ? MOVING_UP : MOVING_DOWN;
+    car.nextFloor = tripTarget<Policy>(car, firstFloorAhead(car.position, dir), dir);
+    car.trip = planTrip(car.motion, std::fabs(car.nextFloor - car.position) * car.motion.floorHeight);
+    planEvent(car);
+}
+
+// Nov poziv tokom voznje: ako se stanica promenila i kabina jos moze da
+// predje na novu voznju bez skoka, menja cilj; inace poziv ceka sledecu voznju
+template <class Policy>
+static void retarget(Car& car, double t) {
+    int dir = (car.liftState == MOVING_UP) ? 1 : -1;
+    int first = firstFloorAhead(carPositionAt(car, t), dir);
+    if (first < 0 || first >= car.carCalls.size()) return;
+
+    int target = tripTarget<Policy>(car, first, dir);
+    if (target == car.nextFloor) return;
+
+    Trip trip = planTrip(car.motion, std::fabs(target - car.position) * car.motion.floorHeight);
+    if (t - car.stateTime > tripDivergence(car.trip, trip) + 1e-9) return; // Kasno: vec koci ili ubrzava drugacije
+
+    car.nextFloor = target;
+    car.trip = trip;
+    planEvent(car);
+}
+
+template <class Policy>
+static void openDoorHere(Car& car, double t) {
+    int f = car.currentFloor;
+    int dir = car.lastDirection;
+
+    // Ako napred nema nista a ceka nas samo poziv u suprotnom smeru, okrecemo
+    const RequestSet& same = (dir == 1) ? car.hallUp : car.hallDown;
+    const RequestSet& opposite = (dir == 1) ? car.hallDown : car.hallUp;
+    if (!Policy::keepsGoing(car, f, dir) && !same.test(f) && opposite.test(f)) {
+        car.lastDirection = -dir;
+    }
+
+    clearAnsweredCalls(car);
+    setState(car, t, DOOR_OPENING);
+    if (car.ventilationOn) car.ventilationOn = false;
+}
+
+template <class Policy>
+void checkRequests(Car& car, double t) {
+    if (car.liftState == MOVING_UP || car.liftState == MOVING_DOWN) {
+        retarget<Policy>(car, t);
+        return;
+    }
+    if (car.liftState != IDLE) return;
+
+    // --- 1. PROVERA: Da li je pozvan na TRENUTNOM spratu (u nasem smeru)? ---
+    if (shouldStopHere<Policy>(car, car.currentFloor, car.lastDirection)) {
+        openDoorHere<Policy>(car, t);
+        return;
+    }
+
+    // Napred nema stanice, a ovde ceka samo poziv u suprotnom smeru: okrecemo se
+    // na mestu (SCAN bi inace stajao, jer bi u nasem smeru isao do kraja okna)
+    int ahead = (car.lastDirection == 1) ? nextStopAbove(car, car.currentFloor) : nextStopBelow(car, car.currentFloor);
+    if (ahead < 0 && shouldStopHere<Policy>(car, car.currentFloor, -car.lastDirection)) {
+        car.lastDirection = -car.lastDirection;
+        openDoorHere<Policy>(car, t);
+        return;
+    }
+
+    // --- 2. LOGIKA KRETANJA ---
+    // Prvo nastavljamo u smeru u kom smo isli, tek onda okrecemo
+    // (dokle se vozi u jednom smeru odlucuje politika, u arriveAtFloor)
+    bool above = nextStopAbove(car, car.currentFloor) >= 0;
+    bool below = nextStopBelow(car, car.currentFloor) >= 0;
+    if (car.lastDirection == 1) {
+        if (above) { startTrip<Policy>(car, t, 1); return; }
+        if (below) { car.lastDirection = -1; startTrip<Policy>(car, t, -1); return; }
+    }
+    else {
+        if (below) { startTrip<Policy>(car, t, -1); return; }
+        if (above) { car.lastDirection = 1; startTrip<Policy>(car, t, 1); return; }
+    }
+}
+
+// Kabina je upravo stala na spratu nextFloor
+template <class Policy>
+static CarEvent arriveAtFloor(Car& car, double t) {
+    int f = car.nextFloor;
+    int dir = (car.liftState == MOVING_UP) ? 1 : -1;
+
+    // Pozivi u suprotnom smeru na spratovima koje je proletela (neusmereni SCAN bi tu stao)
+    const RequestSet& opposite = (dir == 1) ? car.hallDown : car.hallUp;
+    int from = firstFloorAhead(car.position, dir);
+    car.passedOpposite = 0;
+    for (int g = (dir == 1) ? opposite.nextAbove(from - 1) : opposite.nextBelow(from + 1);
+         g >= 0 && g != f && (g - f) * dir < 0;
+         g = (dir == 1) ? opposite.nextAbove(g) : opposite.nextBelow(g)) {
+        car.passedOpposite++;
+    }
+
+    car.position = f; // Tacno na spratu, bez prebacaja
+    car.stateTime = t;
+    car.currentFloor = f;
+    car.trip = Trip();
+    car.liftState = IDLE;
+
+    if (shouldStopHere<Policy>(car, f, dir)) {
+        openDoorHere<Policy>(car, t);
+    }
+    else if (Policy::keepsGoing(car, f, dir)) {
+        startTrip<Policy>(car, t, dir); // Nov poziv iza stanice stigao je kad je vec kocila
+    }
+    else {
+        // Politika kaze da se ovde okrece: biramo iznova
+        setState(car, t, IDLE);
+        checkRequests<Policy>(car, t);
+    }
+    return (car.passedOpposite > 0) ? CAR_PASSED_OPPOSITE : CAR_NONE;
+}
+
+template <class Policy>
+CarEvent handleCarEvent(Car& car, double t) {
+    switch (car.liftState) {
+    case MOVING_UP:
+    case MOVING_DOWN:
+        return arriveAtFloor<Policy>(car, t);
+
+    case DOOR_OPENING:
+        car.doorOpenTimeStart = t; // Pocni merenje 5s
+        car.extendedOnce = false;  // Resetujemo opciju za produzenje
+        setState(car, t, DOOR_OPEN);
+        car.door = 1.0;
+
+        // Kad se vrata otvore, zahtev je ispunjen, gasimo lampicu
+        clearAnsweredCalls(car);
+        return CAR_DOOR_OPENED;
+
+    case DOOR_OPEN:
+        setState(car, t, DOOR_CLOSING);
+        return CAR_NONE;
+
+    case DOOR_CLOSING:
+        setState(car, t, IDLE);
+        car.door = 0.0;
+        checkRequests<Policy>(car, t); // Kad se zatvore, vidi gde dalje
+        return CAR_DOOR_CLOSED;
+
+    default:
+        return CAR_NONE;
+    }
+}
+
+// Varijante za sve politike (bira ih withPolicy u Dispatch.h)
+template void checkRequests<ScanPolicy>(Car&, double);
+template void checkRequests<LookPolicy>(Car&, double);
+template void checkRequests<NearestCarPolicy>(Car&, double);
+template void checkRequests<EtaPolicy>(Car&, double);
+template CarEvent handleCarEvent<ScanPolicy>(Car&, double);
+template CarEvent handleCarEvent<LookPolicy>(Car&, double);
+template CarEvent handleCarEvent<NearestCarPolicy>(Car&, double);
+template CarEvent handleCarEvent<EtaPolicy>(Car&, double);
+
+// --- KOMANDE ---
+bool extendDoor(Car& car, double t) {
+    if (car.liftState == DOOR_OPEN && !car.extendedOnce) {
+        car.doorOpenTimeStart = t;
+        car.extendedOnce = true;
+        planEvent(car);
+        return true;
+    }
+    return false;
+}
+
+void closeDoor(Car& car, double t) {
+    if (car.liftState == DOOR_OPEN) setState(car, t, DOOR_CLOSING);
+}
+
+void emergencyStop(Car& car, double t) {
+    car.carCalls.clear();
+    car.hallUp.clear();
+    car.hallDown.clear();
+    setState(car, t, DOOR_OPENING);
+}
+
+void toggleVentilation(Car& car) {
+    car.ventilationOn = !car.ventilationOn;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "RequestSet.h"
+#include "Kinematics.h"
+
+// --- JEDNA KABINA ---
+// Automat stanja jedne kabine (ranije globalne promenljive u Main.cpp).
+// Kabina ne zna za druge kabine ni za pozive sa spratova koji joj nisu
+// dodeljeni; to resava grupni kontroler u Simulation.cpp.
+//
+// Potpuna kolektivna kontrola: u voznji nagore kabina staje na pozive iz
+// kabine i na pozive "GORE"; poziv "DOLE" uzima tek na mestu okretanja
+// (LOOK: kad nema nista iznad, SCAN: na krajnjem spratu). Nadole obrnuto.
+//
+// Kabina se ne pomera po frejmovima: pozicija i vrata su zapamceni u
+// trenutku poslednje promene stanja (stateTime), a izmedju promena se
+// racunaju analiticki (carPositionAt / carDoorAt). Svako stanje ima najvise
+// jedan sledeci dogadjaj (eventTime) koji simulacija stavlja u red.
+//
+// Voznja ide od mirovanja do mirovanja po profilu iz Kinematics.h, pravo do
+// sledece stanice (nextFloor), bez dogadjaja na spratovima izmedju. Nov poziv
+// usput menja cilj samo ako nova voznja moze da nastavi staru bez skoka,
+// tj. ako kabina jos nije pocela da koci (ili da ubrzava manje) za stari cilj.
+//
+// Opterecenje: kabina zna koliko putnika vozi (load, vodi ga Simulation.cpp)
+// i koliko ih moze da primi (capacity). Kad je opterecenje iznad
+// BYPASS_LOAD, kabina prolazi pored poziva sa spratova i staje samo na
+// pozive iz kabine, dok se ne isprazni ispod praga.
+
+enum LiftState { IDLE, MOVING_UP, MOVING_DOWN, DOOR_OPENING, DOOR_OPEN, DOOR_CLOSING };
+
+const double DOOR_MOVE_TIME = 1.5;  // Trajanje otvaranja/zatvaranja vrata (s)
+const double DOOR_DURATION = 5.0;   // Koliko vrata stoje otvorena (s), podrazumevano za Car::doorDuration
+const int CAR_CAPACITY = 13;        // Nazivna nosivost 1000 kg / 75 kg po putniku
+const double BYPASS_LOAD = 0.8;     // Iznad ovog udela nosivosti kabina ne staje na pozive sa spratova
+
+struct Car {
+    double position = 2.0;          // Pozicija kabine u spratovima (0 = SU), u trenutku stateTime
+    int currentFloor = 2;           // Poslednji sprat na kom je kabina bila (krece sa 1. sprata)
+    int nextFloor = 2;              // Sprat na kom se zavrsava trenutna voznja
+    LiftState liftState = IDLE;
+    int lastDirection = 1;          // Smer voznje / najavljeni smer na stanici: 1 = GORE, -1 = DOLE
+
+    MotionProfile motion;           // Brzina, ubrzanje, trzaj, visina sprata
+    Trip trip;                      // Trenutna voznja, od position u trenutku stateTime
+    int passedOpposite = 0;         // Pozivi u suprotnom smeru preko kojih je presla poslednja voznja
+
+    double door = 0.0;              // Otvorenost vrata (0 = zatvorena, 1 = otvorena), u trenutku stateTime
+    double doorOpenTimeStart = 0.0;
+    double doorDuration = DOOR_DURATION;
+    bool extendedOnce = false;
+    bool ventilationOn = false;
+
+    int capacity = CAR_CAPACITY;    // Najvise putnika u kabini
+    int load = 0;                   // Putnika u kabini
+
+    double stateTime = 0.0;         // Kada je kabina usla u trenutno stanje
+    double eventTime = 0.0;         // Vreme sledeceg dogadjaja kabine (beskonacno ako ga nema)
+    unsigned int version = 0;       // Raste pri svakom novom planu
+    unsigned int queuedVersion = 0; // Verzija koja je vec stavljena u red dogadjaja
+
+    RequestSet carCalls;            // Pozivi iz kabine (dugmad na panelu)
+    RequestSet hallUp;              // Pozivi "GORE" koje je grupa dodelila ovoj kabini
+    RequestSet hallDown;            // Pozivi "DOLE" koje je grupa dodelila ovoj kabini
+};
+
+// Sta se desilo pri obradi dogadjaja kabine (za grupni kontroler i metrike)
+enum CarEvent {
+    CAR_NONE,
+    CAR_DOOR_OPENED,        // Vrata su se upravo otvorila na currentFloor, smer lastDirection
+    CAR_PASSED_OPPOSITE,    // Prosla je spratove sa svojim pozivima u suprotnom smeru (passedOpposite)
+    CAR_DOOR_CLOSED         // Vrata su se zatvorila na currentFloor (kabina je vec izabrala sledeci potez)
+};
+
+void initCar(Car& car, int floorCount, int startFloor);
+
+// Pozicija i otvorenost vrata u trenutku t (t >= car.stateTime)
+double carPositionAt(const Car& car, double t);
+double carDoorAt(const Car& car, double t);
+
+// Da li kabina ima bilo kakav poziv na spratu f, i sledeci takav sprat iznad/ispod
+// (sledeca stanica i hasAnyCall ne broje pozive sa spratova dok je kabina puna)
+bool hasCallAt(const Car& car, int f);
+int nextStopAbove(const Car& car, int f);
+int nextStopBelow(const Car& car, int f);
+bool hasAnyCall(const Car& car);
+
+// Opterecenje iznad BYPASS_LOAD: kabina ne staje na pozive sa spratova
+bool bypassesHallCalls(const Car& car);
+
+// Ako kabina stoji, bira sledeci smer ili otvara vrata na trenutnom spratu.
+// Policy je jedna od politika iz Dispatch.h (instancirane su u Car.cpp).
+template <class Policy>
+void checkRequests(Car& car, double t);
+
+// Obrada dogadjaja kabine u trenutku car.eventTime
+template <class Policy>
+CarEvent handleCarEvent(Car& car, double t);
+
+// --- KOMANDE SA PANELA U KABINI ---
+bool extendDoor(Car& car, double t);    // OTVORI: produzava vrata jednom po otvaranju
+void closeDoor(Car& car, double t);     // ZATVORI
+void emergencyStop(Car& car, double t); // STOP: brise pozive i otvara vrata
+void toggleVentilation(Car& car);
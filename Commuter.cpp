@@ -0,0 +1,56 @@
+#include "Commuter.h"
+
+static ScriptTask commuter(Simulation& sim, CommuterPlan plan, CommuterStats& stats) {
+    ScriptScheduler& s = sim.scripts;
+    co_await sleepUntil(s, plan.appear);
+    stats.started++;
+    co_await delay(s, plan.walk);
+
+    // Poziva i ceka dok ne udje ili ne odustane
+    int dir = (plan.destination > plan.origin) ? CALL_UP : CALL_DOWN;
+    double called = s.now;
+    int car = -1;
+    for (int calls = 0; car < 0; calls++) {
+        int here = carWithOpenDoor(sim, plan.origin, dir);
+        if (here >= 0 && boardCar(sim, here)) { car = here; break; }
+        if (calls == plan.maxCalls) {
+            stats.gaveUp++;
+            co_return;
+        }
+        hallCall(sim, plan.origin, dir);
+        int opened = co_await waitForDoor(s, plan.origin, dir, -1, plan.patience);
+        if (opened >= 0 && boardCar(sim, opened)) car = opened;
+    }
+    record(stats.wait, s.now - called);
+
+    // Vozi se; ako je poziv iz kabine izbrisan (STOP), pritiska ponovo
+    carCall(sim, car, plan.destination);
+    while (co_await waitForDoor(s, plan.destination, 0, car, plan.patience) < 0) {
+        carCall(sim, car, plan.destination);
+    }
+    leaveCar(sim, car);
+    stats.delivered++;
+    record(stats.total, s.now - plan.appear);
+
+    co_await delay(s, plan.walk);
+}
+
+void spawnCommuter(Simulation& sim, const CommuterPlan& plan, CommuterStats& stats) {
+    if (plan.origin < 0 || plan.origin >= sim.floorCount) return;
+    if (plan.destination < 0 || plan.destination >= sim.floorCount || plan.destination == plan.origin) return;
+    sim.scripts.now = sim.time;
+    commuter(sim, plan, stats);
+}
+
+void spawnCommuters(Simulation& sim, int count, double seconds, uint64_t seed, CommuterStats& stats) {
+    Rng rng;
+    rng.state = seed;
+    for (int i = 0; i < count; i++) {
+        CommuterPlan plan;
+        plan.appear = sim.time + rng.uniform() * seconds;
+        plan.origin = rng.below(sim.floorCount);
+        plan.destination = rng.below(sim.floorCount - 1);
+        if (plan.destination >= plan.origin) plan.destination++;
+        spawnCommuter(sim, plan, stats);
+    }
+}
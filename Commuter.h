@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include "Simulation.h"
+
+// --- PUTNIK KAO SKRIPTA ---
+// Primer ponasanja napisanog kao korutina (Script.h): putnik se pojavi,
+// hoda do lifta, pozove ga i ceka koliko mu strpljenje dozvoljava. Ako
+// kabina ne dodje ili je puna, pozove ponovo; posle maxCalls poziva odustaje
+// (ide stepenicama). U kabini pritisne svoj sprat, izadje kad se vrata tu
+// otvore i odlazi.
+
+struct CommuterPlan {
+    double appear = 0.0;        // Kad se putnik pojavi (simulacioni sat)
+    int origin = 0;
+    int destination = 0;
+    double walk = 8.0;          // Hod do lifta i od lifta (s)
+    double patience = 90.0;     // Koliko ceka na vrata pre nego sto pozove ponovo (s)
+    int maxCalls = 3;           // Posle toliko poziva odustaje
+};
+
+// Zbir za sve putnike-skripte jedne simulacije (pisu ga same skripte)
+struct CommuterStats {
+    long long started = 0;
+    long long delivered = 0;
+    long long gaveUp = 0;
+    Histogram wait;             // Prvi poziv -> ulazak
+    Histogram total;            // Pojavljivanje -> izlazak iz kabine
+};
+
+// Pokrece skriptu jednog putnika; stats mora da zivi dok simulacija radi
+void spawnCommuter(Simulation& sim, const CommuterPlan& plan, CommuterStats& stats);
+
+// count putnika sa slucajnim spratovima, rasporedjenih ravnomerno u
+// [sim.time, sim.time + seconds)
+void spawnCommuters(Simulation& sim, int count, double seconds, uint64_t seed, CommuterStats& stats);
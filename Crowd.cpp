@@ -0,0 +1,81 @@
+#include "Crowd.h"
+
+void pushPassenger(PassengerGroup& group, const Passenger& p) {
+    group.origin.push_back(p.origin);
+    group.destination.push_back(p.destination);
+    group.arrivalTime.push_back(p.arrivalTime);
+    group.boardTime.push_back(p.boardTime);
+}
+
+Passenger passengerAt(const PassengerGroup& group, size_t i) {
+    Passenger p;
+    p.origin = group.origin[i];
+    p.destination = group.destination[i];
+    p.arrivalTime = group.arrivalTime[i];
+    p.boardTime = group.boardTime[i];
+    return p;
+}
+
+void clearGroup(PassengerGroup& group) {
+    group.origin.clear();
+    group.destination.clear();
+    group.arrivalTime.clear();
+    group.boardTime.clear();
+}
+
+void assignGroup(PassengerGroup& group, const Passenger* passengers, size_t count) {
+    group.origin.resize(count);
+    group.destination.resize(count);
+    group.arrivalTime.resize(count);
+    group.boardTime.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        group.origin[i] = passengers[i].origin;
+        group.destination[i] = passengers[i].destination;
+        group.arrivalTime[i] = passengers[i].arrivalTime;
+        group.boardTime[i] = passengers[i].boardTime;
+    }
+}
+
+// Prvih count elemenata niza ide na kraj drugog niza
+template <class T>
+static void moveColumn(std::vector<T>& from, size_t count, std::vector<T>& to) {
+    to.insert(to.end(), from.begin(), from.begin() + count);
+    from.erase(from.begin(), from.begin() + count);
+}
+
+void moveFront(PassengerGroup& from, size_t count, PassengerGroup& to, double t) {
+    if (count > from.size()) count = from.size();
+    if (count == 0) return;
+    moveColumn(from.origin, count, to.origin);
+    moveColumn(from.destination, count, to.destination);
+    moveColumn(from.arrivalTime, count, to.arrivalTime);
+    from.boardTime.erase(from.boardTime.begin(), from.boardTime.begin() + count);
+    to.boardTime.resize(to.boardTime.size() + count, t);
+}
+
+// Elementi sa odredistem floor idu u out, ostali se sabijaju na pocetak niza.
+// Niz odredista se deli poslednji: dok se cita destination[i], upisano je
+// samo na mesta < i koja su vec procitana.
+template <class T>
+static void splitColumn(std::vector<T>& column, const std::vector<int>& destination, int floor, std::vector<T>& out) {
+    size_t kept = 0;
+    for (size_t i = 0; i < column.size(); i++) {
+        if (destination[i] != floor) column[kept++] = column[i];
+        else out.push_back(column[i]);
+    }
+    column.resize(kept);
+}
+
+size_t extractDestination(PassengerGroup& group, int floor, PassengerGroup& out) {
+    clearGroup(out);
+
+    size_t leaving = 0;
+    for (int d : group.destination) leaving += (d == floor);
+    if (leaving == 0) return 0;
+
+    splitColumn(group.origin, group.destination, floor, out.origin);
+    splitColumn(group.arrivalTime, group.destination, floor, out.arrivalTime);
+    splitColumn(group.boardTime, group.destination, floor, out.boardTime);
+    splitColumn(group.destination, group.destination, floor, out.destination);
+    return leaving;
+}
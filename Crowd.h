@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Traffic.h"
+
+// --- PUTNICI KAO NIZOVI POLJA ---
+// Grupa putnika (red na jednom spratu u jednom smeru, ili putnici u jednoj
+// kabini) cuva svako polje u svom nizu: polazni sprat, odrediste, vreme
+// dolaska i vreme ulaska. Clanovi grupe su uvek gusto poredjani (0..size-1)
+// po redosledu dolaska, pa:
+//  - ulazak premesta pocetak reda u kabinu jednim kopiranjem po polju,
+//  - izlazak prolazi samo kroz niz odredista i sabija ostale na pocetak,
+//  - statistika se upisuje prolaskom kroz susedne elemente istog niza.
+// Stanje putnika (ceka / vozi se), sprat na kom ceka i mesto u prikazu nisu
+// posebna polja: odredjuje ih grupa u kojoj je i mesto u njoj.
+//
+// Passenger (Traffic.h) ostaje oblik jednog putnika na ulazu (generator,
+// addPassenger) i u snimku stanja.
+
+struct PassengerGroup {
+    std::vector<int> origin;
+    std::vector<int> destination;
+    std::vector<double> arrivalTime;    // Kad je putnik pozvao lift
+    std::vector<double> boardTime;      // Kad je usao u kabinu (0 dok ceka)
+
+    size_t size() const { return destination.size(); }
+    bool empty() const { return destination.empty(); }
+};
+
+void pushPassenger(PassengerGroup& group, const Passenger& p);
+Passenger passengerAt(const PassengerGroup& group, size_t i);
+void clearGroup(PassengerGroup& group);
+
+// Zamenjuje sadrzaj grupe sa count putnika iz niza (ucitavanje snimka)
+void assignGroup(PassengerGroup& group, const Passenger* passengers, size_t count);
+
+// Prvih count putnika iz from prelazi na kraj to, sa vremenom ulaska t
+void moveFront(PassengerGroup& from, size_t count, PassengerGroup& to, double t);
+
+// Putnici sa odredistem floor prelaze iz group u out (out se prvo prazni);
+// ostali ostaju u istom redosledu. Vraca broj putnika koji su izasli.
+size_t extractDestination(PassengerGroup& group, int floor, PassengerGroup& out);
@@ -0,0 +1,176 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "Car.h"
+
+// --- POLITIKE DISPECERA ---
+// Politika se prosledjuje kao parametar sablona (checkRequests<P>,
+// handleCarEvent<P>, kontroler u Simulation.cpp), pa se njene funkcije
+// ugradjuju direktno u petlju simulacije, bez virtuelnih poziva. Izbor u
+// toku rada (sim.policy) samo bira jednu od vec instanciranih varijanti.
+//
+// Svaka politika odgovara na dva pitanja:
+//   keepsGoing(car, f, dir)       - vozi li kabina dalje u smeru dir posle sprata f
+//                                   (ako ne, tu okrece i uzima pozive u suprotnom smeru)
+//   cost(car, t, floor, dir)      - cena dodele poziva sa sprata ovoj kabini (manje = bolje)
+
+enum DispatchPolicy {
+    DISPATCH_SCAN,      // Vozi do krajnjeg sprata pa okrece; dodela po duzini tog puta
+    DISPATCH_LOOK,      // Okrece kod poslednjeg poziva; dodela po duzini tog puta
+    DISPATCH_NEAREST,   // Najbliza kabina, bez obzira na smer i obaveze
+    DISPATCH_ETA,       // LOOK + procena vremena dolaska po profilu kretanja, sa stanicama koje kabina vec ima
+    DISPATCH_POLICY_COUNT
+};
+
+inline const char* policyName(DispatchPolicy policy) {
+    switch (policy) {
+    case DISPATCH_SCAN:    return "SCAN";
+    case DISPATCH_LOOK:    return "LOOK";
+    case DISPATCH_NEAREST: return "NAJBLIZA";
+    default:               return "ETA";
+    }
+}
+
+// Put (u spratovima) koji kabina prelazi do sprata floor da bi tamo krenula
+// u smeru dir, ako krajnje tacke njene voznje dosezu do top i bottom
+inline double sweepDistance(const Car& car, double t, int floor, int dir, int top, int bottom) {
+    double pos = carPositionAt(car, t);
+
+    int carDir = 0;
+    if (car.liftState == MOVING_UP) carDir = 1;
+    else if (car.liftState == MOVING_DOWN) carDir = -1;
+    else if (car.liftState != IDLE) carDir = car.lastDirection;
+
+    if (top < floor) top = floor;
+    if (bottom > floor) bottom = floor;
+
+    if (carDir == 0) return std::fabs(pos - floor);
+    if (carDir == 1) {
+        if (dir == 1 && floor >= pos) return floor - pos;
+        if (dir == -1) return std::fabs(top - pos) + (top - floor);
+        return std::fabs(top - pos) + (top - bottom) + (floor - bottom);
+    }
+    if (dir == -1 && floor <= pos) return pos - floor;
+    if (dir == 1) return std::fabs(pos - bottom) + (floor - bottom);
+    return std::fabs(pos - bottom) + (top - bottom) + (top - floor);
+}
+
+// Spratova u sekundi pri punoj brzini (za politike koje gledaju samo put)
+inline double cruiseFloorsPerSecond(const Car& car) {
+    return car.motion.maxSpeed / car.motion.floorHeight;
+}
+
+// Najvisi i najnizi sprat do kog kabina stize zbog svojih poziva
+inline int lookTop(const Car& car) {
+    int top = nextStopBelow(car, car.carCalls.size());
+    return (top < car.currentFloor) ? car.currentFloor : top;
+}
+
+inline int lookBottom(const Car& car) {
+    int bottom = nextStopAbove(car, -1);
+    return (bottom < 0 || bottom > car.currentFloor) ? car.currentFloor : bottom;
+}
+
+// Procena vremena (s) za koje kabina stize na sprat floor i moze da krene u
+// smeru dir: LOOK putanja razbijena na voznje izmedju stanica koje kabina
+// vec ima, svaka po profilu kretanja (travelTime), plus vrata na svakoj.
+// Koristi je ETA dispecer, a i najava dolaska na spratu (hallCallEta).
+inline double estimatedArrival(const Car& car, double t, int floor, int dir) {
+    const double stopTime = 2.0 * DOOR_MOVE_TIME + car.doorDuration;
+    int top = lookTop(car);
+    int bottom = lookBottom(car);
+    double target = sweepDistance(car, t, floor, dir, top, bottom);
+
+    // Stanice pre cilja, kao predjeni put duz putanje (poziv iz kabine kad prvi put naidje)
+    thread_local std::vector<double> stops;
+    stops.clear();
+    auto addStop = [&](double d) { if (d < target - 1e-9) stops.push_back(d); };
+    for (int g = car.carCalls.nextAbove(-1); g >= 0; g = car.carCalls.nextAbove(g)) {
+        addStop(std::min(sweepDistance(car, t, g, 1, top, bottom), sweepDistance(car, t, g, -1, top, bottom)));
+    }
+    for (int g = car.hallUp.nextAbove(-1); g >= 0; g = car.hallUp.nextAbove(g)) addStop(sweepDistance(car, t, g, 1, top, bottom));
+    for (int g = car.hallDown.nextAbove(-1); g >= 0; g = car.hallDown.nextAbove(g)) addStop(sweepDistance(car, t, g, -1, top, bottom));
+    std::sort(stops.begin(), stops.end());
+    stops.erase(std::unique(stops.begin(), stops.end(), [](double a, double b) { return b - a < 1e-9; }), stops.end());
+
+    // Ono sto je kabina vec zapocela: voznju do nextFloor ili ciklus vrata
+    double time = 0.0;
+    double at = 0.0;
+    double remaining = car.eventTime - t;
+    switch (car.liftState) {
+    case MOVING_UP:
+    case MOVING_DOWN: {
+        double toNext = std::fabs(car.nextFloor - carPositionAt(car, t));
+        if (target < toNext) return remaining * target / toNext; // Cilj je usput, pre kraja voznje
+        time = remaining;
+        at = toNext;
+        break;
+    }
+    case DOOR_OPENING: time = remaining + car.doorDuration + DOOR_MOVE_TIME; break;
+    case DOOR_OPEN:    time = remaining + DOOR_MOVE_TIME; break;
+    case DOOR_CLOSING: time = remaining; break;
+    default: break;
+    }
+
+    for (double d : stops) {
+        if (d < at - 1e-9) continue;                        // Iza kabine (ne bi trebalo da se desi)
+        if (d > at + 1e-9) time += travelTime(car.motion, at, d);
+        time += stopTime;
+        at = d;
+    }
+    if (target > at) time += travelTime(car.motion, at, target);
+    return time;
+}
+
+struct ScanPolicy {
+    static bool keepsGoing(const Car& car, int f, int dir) {
+        if (!hasAnyCall(car)) return false;
+        return (dir == 1) ? f < car.carCalls.size() - 1 : f > 0;
+    }
+
+    static double cost(const Car& car, double t, int floor, int dir) {
+        return sweepDistance(car, t, floor, dir, car.carCalls.size() - 1, 0) / cruiseFloorsPerSecond(car);
+    }
+};
+
+struct LookPolicy {
+    static bool keepsGoing(const Car& car, int f, int dir) {
+        return (dir == 1) ? nextStopAbove(car, f) >= 0 : nextStopBelow(car, f) >= 0;
+    }
+
+    static double cost(const Car& car, double t, int floor, int dir) {
+        return sweepDistance(car, t, floor, dir, lookTop(car), lookBottom(car)) / cruiseFloorsPerSecond(car);
+    }
+};
+
+struct NearestCarPolicy {
+    static bool keepsGoing(const Car& car, int f, int dir) {
+        return LookPolicy::keepsGoing(car, f, dir);
+    }
+
+    static double cost(const Car& car, double t, int floor, int /*dir*/) {
+        return std::fabs(carPositionAt(car, t) - floor) / cruiseFloorsPerSecond(car);
+    }
+};
+
+struct EtaPolicy {
+    static bool keepsGoing(const Car& car, int f, int dir) {
+        return LookPolicy::keepsGoing(car, f, dir);
+    }
+
+    static double cost(const Car& car, double t, int floor, int dir) {
+        return estimatedArrival(car, t, floor, dir);
+    }
+};
+
+// Poziva f sa instancom politike koja odgovara izboru u toku rada
+template <class F>
+decltype(auto) withPolicy(DispatchPolicy policy, F&& f) {
+    switch (policy) {
+    case DISPATCH_SCAN:    return f(ScanPolicy());
+    case DISPATCH_LOOK:    return f(LookPolicy());
+    case DISPATCH_NEAREST: return f(NearestCarPolicy());
+    default:               return f(EtaPolicy());
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+// --- RED DOGADJAJA ---
+// Min-heap vremenskih dogadjaja. Dogadjaji sa istim vremenom izlaze po
+// redosledu ubacivanja (seq), pa je simulacija deterministicka.
+// Heap je obican niz (std::push_heap / pop_heap), pa snimak (Snapshot.h)
+// moze da ga prepise kakav jeste i da posle vracanja red bude isti.
+
+enum EventType {
+    EV_FLOOR_ARRIVAL,   // Kabina je stigla do sledeceg sprata
+    EV_DOOR_OPENED,     // Vrata su se potpuno otvorila
+    EV_DWELL_END,       // Isteklo je vreme stajanja sa otvorenim vratima
+    EV_DOOR_CLOSED,     // Vrata su se potpuno zatvorila
+    EV_HALL_CALL,       // Putnik je pozvao lift sa sprata
+    EV_PASSENGER_ARRIVAL // Generator saobracaja: sledeci putnik stize na sprat
+};
+
+struct Event {
+    double time;
+    unsigned long long seq;
+    EventType type;
+    int car;                // Kabina (za dogadjaje kabine)
+    unsigned int version;   // Verzija plana kabine (ili generatora); zastareli dogadjaji se preskacu
+    int floor;              // Za EV_HALL_CALL
+    int dir;                // Za EV_HALL_CALL
+};
+
+class EventQueue {
+public:
+    void push(Event e) {
+        e.seq = nextSeq++;
+        heap.push_back(e);
+        std::push_heap(heap.begin(), heap.end(), Later());
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    const Event& top() const { return heap.front(); }
+
+    void pop() {
+        std::pop_heap(heap.begin(), heap.end(), Later());
+        heap.pop_back();
+    }
+
+    void clear() {
+        heap.clear();
+        nextSeq = 0;
+    }
+
+    // Sirov heap (redosled u nizu je redosled heap-a) i sledeci seq, za snimke
+    const Event* data() const { return heap.data(); }
+    unsigned long long sequence() const { return nextSeq; }
+    void assign(const Event* events, size_t count, unsigned long long sequence) {
+        heap.assign(events, events + count);
+        nextSeq = sequence;
+    }
+
+private:
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const {
+            if (a.time != b.time) return a.time > b.time;
+            return a.seq > b.seq;
+        }
+    };
+
+    std::vector<Event> heap;
+    unsigned long long nextSeq = 0;
+};
@@ -0,0 +1,62 @@
+#include "Histogram.h"
+
+#include <bit>
+
+// Korpa za vrednost v (ms): do 2 * SUB_COUNT tacno, iznad toga gornjih
+// SUB_BITS + 1 bitova odredjuje korpu unutar stepena dvojke
+static int bucketIndex(uint64_t v) {
+    if (v < 2 * Histogram::SUB_COUNT) return (int)v;
+    int top = std::bit_width(v) - 1;
+    int shift = top - Histogram::SUB_BITS;
+    return shift * Histogram::SUB_COUNT + (int)(v >> shift);
+}
+
+// Sredina korpe u ms
+static double bucketValue(int index) {
+    if (index < 2 * Histogram::SUB_COUNT) return index;
+    int shift = index / Histogram::SUB_COUNT - 1;
+    uint64_t low = (uint64_t)(index % Histogram::SUB_COUNT + Histogram::SUB_COUNT) << shift;
+    return low + (double)(1ull << shift) * 0.5;
+}
+
+void record(Histogram& h, double seconds) {
+    if (seconds < 0.0) seconds = 0.0;
+    const double maxMs = (double)((1ull << Histogram::MAX_BITS) - 1);
+    double ms = seconds * 1000.0;
+    if (ms > maxMs) ms = maxMs;
+
+    h.counts[bucketIndex((uint64_t)ms)]++;
+    h.count++;
+    h.sum += seconds;
+    if (seconds > h.max) h.max = seconds;
+}
+
+void merge(Histogram& a, const Histogram& b) {
+    for (int i = 0; i < Histogram::BUCKETS; i++) a.counts[i] += b.counts[i];
+    a.count += b.count;
+    a.sum += b.sum;
+    if (b.max > a.max) a.max = b.max;
+}
+
+double mean(const Histogram& h) {
+    return h.count ? h.sum / (double)h.count : 0.0;
+}
+
+double percentile(const Histogram& h, double p) {
+    if (h.count == 0) return 0.0;
+    if (p >= 100.0) return h.max;
+
+    // Redni broj trazenog upisa (1..count)
+    uint64_t rank = (uint64_t)(p / 100.0 * (double)h.count + 0.5);
+    if (rank < 1) rank = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < Histogram::BUCKETS; i++) {
+        seen += h.counts[i];
+        if (seen >= rank) {
+            double value = bucketValue(i) / 1000.0;
+            return (value > h.max) ? h.max : value;
+        }
+    }
+    return h.max;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+// --- HISTOGRAM VREMENA (HDR) ---
+// Log-linearni histogram fiksne velicine: vrednosti do 64 ms su tacne, a
+// iznad toga svaki stepen dvojke je podeljen na 32 korpe (greska ispod
+// ~3%). Opseg je do 2^32 ms (~50 dana); vece vrednosti idu u poslednju
+// korpu. Upis je samo sabiranje u niz, bez alokacije, pa moze da stoji na
+// vrucoj putanji i kad kroz simulaciju prodju milioni putnika.
+
+struct Histogram {
+    static const int SUB_BITS = 5;                              // 2^5 = 32 korpe po stepenu dvojke
+    static const int SUB_COUNT = 1 << SUB_BITS;
+    static const int MAX_BITS = 32;                             // Najveca vrednost: 2^32 - 1 ms
+    static const int BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+    uint32_t counts[BUCKETS] = {};
+    uint64_t count = 0;
+    double sum = 0.0;               // Zbir u sekundama (za prosek)
+    double max = 0.0;               // Najveca upisana vrednost (s)
+};
+
+// Upis vremena u sekundama (negativna vremena se racunaju kao 0)
+void record(Histogram& h, double seconds);
+
+// Spaja b u a (npr. zbir po spratovima)
+void merge(Histogram& a, const Histogram& b);
+
+double mean(const Histogram& h);
+
+// Vrednost (s) ispod koje je dati procenat upisa, p u [0, 100]
+double percentile(const Histogram& h, double p);
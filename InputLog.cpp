@@ -0,0 +1,137 @@
+#include "InputLog.h"
+
+#include <cstring>
+
+static uint64_t packPair(float a, float b) {
+    uint32_t ua, ub;
+    std::memcpy(&ua, &a, sizeof(ua));
+    std::memcpy(&ub, &b, sizeof(ub));
+    return (uint64_t)ua | ((uint64_t)ub << 32);
+}
+
+static void unpackPair(uint64_t value, float& a, float& b) {
+    uint32_t ua = (uint32_t)value, ub = (uint32_t)(value >> 32);
+    std::memcpy(&a, &ua, sizeof(a));
+    std::memcpy(&b, &ub, sizeof(b));
+}
+
+InputRecord keyRecord(int key, int action, int mods) {
+    InputRecord r;
+    r.type = INPUT_KEY;
+    r.action = (uint8_t)action;
+    r.mods = (uint8_t)mods;
+    r.value = (uint64_t)(uint32_t)key;
+    return r;
+}
+
+InputRecord clickRecord(int button, int action, float x, float y) {
+    InputRecord r;
+    r.type = INPUT_CLICK;
+    r.action = (uint8_t)action;
+    r.button = (uint8_t)button;
+    r.value = packPair(x, y);
+    return r;
+}
+
+InputRecord resizeRecord(float width, float height) {
+    InputRecord r;
+    r.type = INPUT_RESIZE;
+    r.value = packPair(width, height);
+    return r;
+}
+
+void applyInput(App& app, const InputRecord& record) {
+    float a, b;
+    switch (record.type) {
+    case INPUT_KEY:
+        keyApp(app, (int)(uint32_t)record.value, record.action, record.mods);
+        break;
+    case INPUT_CLICK:
+        unpackPair(record.value, a, b);
+        clickApp(app, record.button, record.action, a, b);
+        break;
+    case INPUT_RESIZE:
+        unpackPair(record.value, a, b);
+        resizeApp(app, a, b);
+        break;
+    default:
+        break;
+    }
+}
+
+bool openRecording(InputRecorder& rec, const std::string& path, const App& app) {
+    rec.out.open(path, std::ios::binary | std::ios::trunc);
+    if (!rec.out) return false;
+
+    InputLogHeader header;
+    header.floors = (uint32_t)app.sim.floorCount;
+    header.cars = (uint32_t)app.sim.cars.size();
+    header.seed = app.seed;
+    rec.out.write((const char*)&header, sizeof(header));
+    return true;
+}
+
+void writeRecord(InputRecorder& rec, const InputRecord& record) {
+    if (rec.out.is_open()) rec.out.write((const char*)&record, sizeof(record));
+}
+
+static void writeHash(InputRecorder& rec, const App& app) {
+    InputRecord r;
+    r.tick = (uint64_t)app.ticks;
+    r.type = INPUT_HASH;
+    r.value = hashApp(app);
+    writeRecord(rec, r);
+}
+
+void stepRecorded(App& app, InputRecorder& rec) {
+    stepApp(app);
+    if (app.ticks % INPUT_HASH_INTERVAL == 0 && rec.out.is_open()) {
+        writeHash(rec, app);
+        rec.out.flush(); // Ako se program srusi, snimak vazi bar do poslednjeg otiska
+    }
+}
+
+void closeRecording(InputRecorder& rec, const App& app) {
+    if (!rec.out.is_open()) return;
+    writeHash(rec, app);
+    InputRecord end;
+    end.tick = (uint64_t)app.ticks;
+    end.type = INPUT_END;
+    writeRecord(rec, end);
+    rec.out.close();
+}
+
+bool loadInputLog(const std::string& path, InputLogHeader& header, std::vector<InputRecord>& records) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    if (!in.read((char*)&header, sizeof(header))) return false;
+    if (header.magic != INPUT_LOG_MAGIC || header.version != INPUT_LOG_VERSION) return false;
+
+    records.clear();
+    InputRecord r;
+    while (in.read((char*)&r, sizeof(r))) records.push_back(r);
+    return true;
+}
+
+ReplayResult replayInputLog(const InputLogHeader& header, const std::vector<InputRecord>& records) {
+    App app;
+    initApp(app, header.seed, (int)header.floors, (int)header.cars);
+    app.echo = false;
+
+    ReplayResult result;
+    for (const InputRecord& r : records) {
+        while (app.ticks < (long long)r.tick) stepApp(app);
+
+        if (r.type == INPUT_END) break;
+        if (r.type == INPUT_HASH) {
+            result.hashesChecked++;
+            if (result.firstMismatch < 0 && hashApp(app) != r.value) result.firstMismatch = (long long)r.tick;
+            continue;
+        }
+        applyInput(app, r);
+        result.inputs++;
+    }
+    result.ticks = app.ticks;
+    result.finalHash = hashApp(app);
+    return result;
+}
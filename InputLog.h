@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "App.h"
+
+// --- SNIMAK ULAZA ---
+// Binarni zapis svega sto prozor prosledi App-u (taster, klik, promena
+// velicine), sa brojem koraka u kom je ulaz stigao, plus otisak stanja
+// (hashApp) na svakih INPUT_HASH_INTERVAL koraka. Ponovljeno izvodjenje
+// (replayInputLog) pravi isti broj koraka i ubacuje isti ulaz izmedju istih
+// koraka, pa stanje mora da se poklopi bit po bit; prvi otisak koji se ne
+// poklopi kaze od kog koraka se izvodjenja razilaze.
+//
+// Format (little-endian, kako ga masina zapise):
+//   InputLogHeader, pa niz InputRecord do INPUT_END.
+
+const uint32_t INPUT_LOG_MAGIC = 0x4345524C;   // "LREC"
+const uint32_t INPUT_LOG_VERSION = 3;          // 2: otisak ukljucuje opterecenje kabina, 3: 64-bitni tick
+const int INPUT_HASH_INTERVAL = 60;             // Koraka izmedju dva otiska (1 s)
+
+enum InputType : uint8_t {
+    INPUT_KEY,          // value = taster
+    INPUT_CLICK,        // value = x, y (float), button = dugme misa
+    INPUT_RESIZE,       // value = sirina, visina (float)
+    INPUT_HASH,         // value = hashApp posle koraka tick
+    INPUT_END           // Snimak je zatvoren u koraku tick
+};
+
+struct InputLogHeader {
+    uint32_t magic = INPUT_LOG_MAGIC;
+    uint32_t version = INPUT_LOG_VERSION;
+    uint32_t floors = 0;
+    uint32_t cars = 0;
+    uint64_t seed = 0;
+};
+
+// 24 bajta po zapisu; tick je pun app.ticks (32 bita bi se prelila posle ~2 godine na 60 Hz)
+struct InputRecord {
+    uint64_t tick = 0;      // app.ticks u trenutku ulaza
+    uint8_t type = INPUT_KEY;
+    uint8_t action = 0;     // APP_PRESS / APP_REPEAT / APP_RELEASE
+    uint8_t mods = 0;
+    uint8_t button = 0;
+    uint8_t pad[4] = {};    // Eksplicitno nule, da snimak ne nosi smece iz memorije
+    uint64_t value = 0;
+};
+static_assert(sizeof(InputRecord) == 24, "InputRecord je deo formata snimka");
+
+// Zapisi ulaza; tick upisuje onaj ko ih primenjuje (app.ticks u tom trenutku)
+InputRecord keyRecord(int key, int action, int mods);
+InputRecord clickRecord(int button, int action, float x, float y);
+InputRecord resizeRecord(float width, float height);
+
+// Prosledjuje ulaz App-u (isto za prozor i za ponovljeno izvodjenje)
+void applyInput(App& app, const InputRecord& record);
+
+struct InputRecorder {
+    std::ofstream out;
+};
+
+bool openRecording(InputRecorder& rec, const std::string& path, const App& app);
+void writeRecord(InputRecorder& rec, const InputRecord& record);
+
+// Korak App-a; na svakih INPUT_HASH_INTERVAL koraka u snimak ide otisak
+void stepRecorded(App& app, InputRecorder& rec);
+
+// Zavrsni otisak i INPUT_END
+void closeRecording(InputRecorder& rec, const App& app);
+
+bool loadInputLog(const std::string& path, InputLogHeader& header, std::vector<InputRecord>& records);
+
+struct ReplayResult {
+    long long ticks = 0;
+    long long inputs = 0;
+    long long hashesChecked = 0;
+    long long firstMismatch = -1;   // Korak prvog otiska koji se ne poklapa (-1 = svi se poklapaju)
+    uint64_t finalHash = 0;
+};
+
+// Bez prozora i bez cekanja: koraci idu jedan za drugim sto brze moze
+ReplayResult replayInputLog(const InputLogHeader& header, const std::vector<InputRecord>& records);
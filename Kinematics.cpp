@@ -0,0 +1,95 @@
+#include "Kinematics.h"
+
+#include <cmath>
+
+Trip planTrip(const MotionProfile& motion, double distance) {
+    Trip trip;
+    trip.distance = distance;
+    if (distance <= 0.0) return trip;
+
+    const double J = motion.jerk;
+    const double A = motion.acceleration;
+    const double V = motion.maxSpeed;
+    const double fullAccelSpeed = A * A / J; // Ispod ove brzine ubrzanje ne stigne do A
+
+    // Put potreban da se iz mirovanja dostigne brzina v (isti je i za kocenje)
+    auto rampDistance = [&](double v) {
+        if (v >= fullAccelSpeed) return v * (v / A + A / J) / 2.0;
+        return v * std::sqrt(v / J);
+    };
+
+    // Najveca brzina koja se stigne na ovoj duzini
+    double v = V;
+    if (2.0 * rampDistance(V) > distance) {
+        v = (-A * A / J + std::sqrt(A * A * A * A / (J * J) + 4.0 * A * distance)) / 2.0;
+        if (v < fullAccelSpeed) v = std::cbrt(distance * distance * J / 4.0);
+    }
+
+    double t1 = (v >= fullAccelSpeed) ? A / J : std::sqrt(v / J);
+    double t2 = v / (J * t1) - t1;
+    if (t2 < 0.0) t2 = 0.0;
+    double t4 = (distance - 2.0 * rampDistance(v)) / v;
+    if (t4 < 0.0) t4 = 0.0;
+
+    const double jerk[Trip::PHASES] = { J, 0.0, -J, 0.0, -J, 0.0, J };
+    const double duration[Trip::PHASES] = { t1, t2, t1, t4, t1, t2, t1 };
+    for (int i = 0; i < Trip::PHASES; i++) {
+        trip.jerk[i] = jerk[i];
+        trip.duration[i] = duration[i];
+        trip.totalTime += duration[i];
+    }
+    trip.peakSpeed = v;
+    return trip;
+}
+
+// Stanje voznje u trenutku t: svaka faza ima konstantan trzaj, pa je put polinom treceg stepena
+static void tripStateAt(const Trip& trip, double t, double& x, double& v) {
+    double a = 0.0;
+    x = 0.0;
+    v = 0.0;
+    for (int i = 0; i < Trip::PHASES && t > 0.0; i++) {
+        double dt = (t < trip.duration[i]) ? t : trip.duration[i];
+        double j = trip.jerk[i];
+        x += v * dt + a * dt * dt / 2.0 + j * dt * dt * dt / 6.0;
+        v += a * dt + j * dt * dt / 2.0;
+        a += j * dt;
+        t -= dt;
+    }
+}
+
+double tripDistanceAt(const Trip& trip, double t) {
+    if (t <= 0.0) return 0.0;
+    if (t >= trip.totalTime) return trip.distance;
+    double x, v;
+    tripStateAt(trip, t, x, v);
+    return (x > trip.distance) ? trip.distance : x;
+}
+
+double tripSpeedAt(const Trip& trip, double t) {
+    if (t <= 0.0 || t >= trip.totalTime) return 0.0;
+    double x, v;
+    tripStateAt(trip, t, x, v);
+    return v;
+}
+
+// Voznje iz istog stanja se poklapaju dok im je trzaj isti; trazimo prvu razliku
+double tripDivergence(const Trip& a, const Trip& b) {
+    int i = 0, j = 0;
+    double restA = a.duration[0], restB = b.duration[0];
+    double t = 0.0;
+    while (i < Trip::PHASES && j < Trip::PHASES) {
+        if (restA <= 0.0) { if (++i < Trip::PHASES) restA = a.duration[i]; continue; }
+        if (restB <= 0.0) { if (++j < Trip::PHASES) restB = b.duration[j]; continue; }
+        if (a.jerk[i] != b.jerk[j]) return t;
+
+        double step = (restA < restB) ? restA : restB;
+        t += step;
+        restA -= step;
+        restB -= step;
+    }
+    return t;
+}
+
+double travelTime(const MotionProfile& motion, double fromFloor, double toFloor) {
+    return planTrip(motion, std::fabs(toFloor - fromFloor) * motion.floorHeight).totalTime;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+// --- KINEMATIKA KABINE ---
+// Voznja sa ogranicenim trzajem (jerk): ubrzanje raste linearno do
+// najveceg, brzina do najvece, pa se sve ponavlja unazad do zaustavljanja.
+// Profil ima najvise 7 faza i sve se racuna u zatvorenom obliku, pa vreme
+// voznje izmedju bilo koja dva sprata ne trazi korake simulacije.
+//
+//   faza:   1     2     3      4       5     6     7
+//   trzaj: +J     0    -J      0      -J     0    +J
+//          |-- ubrzanje --| voznja |-- kocenje --|
+
+struct MotionProfile {
+    double maxSpeed = 1.6;          // m/s
+    double acceleration = 1.0;      // m/s^2
+    double jerk = 1.6;              // m/s^3
+    double floorHeight = 3.5;       // m
+};
+
+// Jedna voznja od mirovanja do mirovanja na udaljenosti distance (m)
+struct Trip {
+    static const int PHASES = 7;
+    double jerk[PHASES] = {};       // Trzaj u svakoj fazi (m/s^3)
+    double duration[PHASES] = {};   // Trajanje svake faze (s)
+    double distance = 0.0;          // m
+    double totalTime = 0.0;         // s
+    double peakSpeed = 0.0;         // m/s
+};
+
+Trip planTrip(const MotionProfile& motion, double distance);
+
+// Predjeni put (m) i brzina (m/s) u trenutku t od polaska (t se ogranicava na [0, totalTime])
+double tripDistanceAt(const Trip& trip, double t);
+double tripSpeedAt(const Trip& trip, double t);
+
+// Poslednji trenutak (s od polaska) do kog se dve voznje sa istim polaskom
+// poklapaju; do tada kabina moze da predje sa jedne na drugu bez skoka
+double tripDivergence(const Trip& a, const Trip& b);
+
+// Vreme voznje (s) izmedju dva sprata (ili dela sprata), iz mirovanja u mirovanje
+double travelTime(const MotionProfile& motion, double fromFloor, double toFloor);
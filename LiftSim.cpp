@@ -0,0 +1,437 @@
+// --- HEADLESS POKRETANJE SIMULACIJE ---
+// Vrti isto jezgro kao prozor (Simulation.h), ali bez GLFW-a i bez cekanja
+// na realno vreme: simulacija skace iz dogadjaja u dogadjaj, pa nedelja
+// saobracaja u zgradi prolazi za delic sekunde.
+//
+// Upotreba: LiftSim [--hours 24] [--seed 1] [--floors 8] [--cars 1]
+//                  [--traffic interfloor|up|down|lunch] [--rate 120]
+//                  [--mix ulaz,izlaz,medju] [--policy scan|look|nearest|eta]
+//                  [--speed 1.6] [--accel 1.0] [--jerk 1.6] [--floor-height 3.5]
+//                  [--door 5] [--capacity 13] [--commuters 0]
+//                  [--sweep] [--threads 0] [--out rezultati.csv]
+//         LiftSim --batch 4096 [--steps 10000] [--floors 8] [--rate 120] [--seed 1]
+//         LiftSim --replay lift_input.rec
+//         LiftSim --check
+//
+// --save snimak.snap cuva stanje na kraju (jedna simulacija ili --batch), a
+// --start snimak.snap krece od sacuvanog stanja umesto od prazne zgrade
+// (spratovi i kabine su iz snimka; --hours je koliko se vrti posle njega).
+//
+// --cars, --policy, --door, --speed, --capacity i --seed primaju i listu (npr. --cars 2,4,6).
+// Vise vrednosti (ili --sweep) pokrece pretragu: svaka kombinacija je zasebna
+// simulacija na jednoj od niti, a rezultat je jedan CSV red po kombinaciji.
+//
+// --commuters N dodaje N putnika napisanih kao korutine (Commuter.h), uz
+// saobracaj iz generatora, i ispisuje njihova vremena i bazen okvira.
+//
+// --batch K meri BatchEnv (K zgrada u koraku) sa jednostavnim pravilom umesto
+// naucenog dispecera: otvori ako je poziv ovde, inace idi ka najblizem pozivu.
+//
+// --replay ponavlja snimak ulaza iz prozora (InputLog.h) bez prozora i
+// proverava da li se svaki zapisani otisak stanja poklapa.
+//
+// --check vrti kratke scenarije sa poznatim ishodom, za svaku politiku.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <bit>
+
+#include "Simulation.h"
+#include "Sweep.h"
+#include "BatchEnv.h"
+#include "InputLog.h"
+#include "Snapshot.h"
+#include "Commuter.h"
+
+struct Options {
+    SweepGrid grid;
+    TrafficPattern traffic = TRAFFIC_INTERFLOOR;
+    double rate = 120.0;            // Putnika na sat
+    bool customMix = false;
+    double incoming = 0.0, outgoing = 0.0;
+
+    bool check = false;             // Kratki scenariji sa poznatim ishodom
+    bool sweep = false;             // CSV izlaz i kad je kombinacija samo jedna
+    int threads = 0;                // 0 = koliko jezgara masina ima
+    std::string out;                // Prazno = standardni izlaz
+
+    int batch = 0;                  // > 0: merenje BatchEnv sa toliko zgrada
+    int batchSteps = 10000;
+
+    std::string replay;             // Snimak ulaza za ponavljanje
+    std::string save;               // Snimak stanja na kraju
+    int commuters = 0;              // Putnika-skripti (jedna simulacija)
+};
+
+// "a,b,c" -> elementi
+static std::vector<std::string> splitList(const std::string& value) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (true) {
+        size_t comma = value.find(',', start);
+        items.push_back(value.substr(start, comma - start));
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return items;
+}
+
+static bool parsePattern(const std::string& name, TrafficPattern& pattern) {
+    if (name == "interfloor") pattern = TRAFFIC_INTERFLOOR;
+    else if (name == "up") pattern = TRAFFIC_UP_PEAK;
+    else if (name == "down") pattern = TRAFFIC_DOWN_PEAK;
+    else if (name == "lunch") pattern = TRAFFIC_LUNCH;
+    else return false;
+    return true;
+}
+
+static bool parsePolicy(const std::string& name, DispatchPolicy& policy) {
+    if (name == "scan") policy = DISPATCH_SCAN;
+    else if (name == "look") policy = DISPATCH_LOOK;
+    else if (name == "nearest") policy = DISPATCH_NEAREST;
+    else if (name == "eta") policy = DISPATCH_ETA;
+    else return false;
+    return true;
+}
+
+static bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--sweep") { opt.sweep = true; continue; }
+        if (arg == "--check") { opt.check = true; continue; }
+        if (i + 1 >= argc) { std::cout << "Nedostaje vrednost za " << arg << std::endl; return false; }
+        std::string value = argv[++i];
+
+        Scenario& base = opt.grid.base;
+        if (arg == "--hours") base.hours = std::stod(value);
+        else if (arg == "--floors") base.floors = std::stoi(value);
+        else if (arg == "--rate") opt.rate = std::stod(value);
+        else if (arg == "--accel") base.motion.acceleration = std::stod(value);
+        else if (arg == "--jerk") base.motion.jerk = std::stod(value);
+        else if (arg == "--floor-height") base.motion.floorHeight = std::stod(value);
+        else if (arg == "--threads") opt.threads = std::stoi(value);
+        else if (arg == "--out") opt.out = value;
+        else if (arg == "--batch") opt.batch = std::stoi(value);
+        else if (arg == "--steps") opt.batchSteps = std::stoi(value);
+        else if (arg == "--replay") opt.replay = value;
+        else if (arg == "--save") opt.save = value;
+        else if (arg == "--commuters") opt.commuters = std::stoi(value);
+        else if (arg == "--start") opt.grid.base.start = value;
+        else if (arg == "--seed") { for (const std::string& v : splitList(value)) opt.grid.seeds.push_back(std::stoull(v)); }
+        else if (arg == "--cars") { for (const std::string& v : splitList(value)) opt.grid.cars.push_back(std::stoi(v)); }
+        else if (arg == "--door") { for (const std::string& v : splitList(value)) opt.grid.doorDurations.push_back(std::stod(v)); }
+        else if (arg == "--speed") { for (const std::string& v : splitList(value)) opt.grid.speeds.push_back(std::stod(v)); }
+        else if (arg == "--capacity") { for (const std::string& v : splitList(value)) opt.grid.capacities.push_back(std::stoi(v)); }
+        else if (arg == "--policy") {
+            for (const std::string& v : splitList(value)) {
+                DispatchPolicy policy;
+                if (!parsePolicy(v, policy)) { std::cout << "Nepoznata politika: " << v << std::endl; return false; }
+                opt.grid.policies.push_back(policy);
+            }
+        }
+        else if (arg == "--traffic") {
+            if (!parsePattern(value, opt.traffic)) { std::cout << "Nepoznat saobracaj: " << value << std::endl; return false; }
+        }
+        else if (arg == "--mix") {
+            // Udeli ulaza i izlaza; ostatak je saobracaj izmedju spratova
+            size_t comma = value.find(',');
+            if (comma == std::string::npos) { std::cout << "--mix ocekuje ulaz,izlaz[,medju]" << std::endl; return false; }
+            opt.incoming = std::stod(value.substr(0, comma));
+            opt.outgoing = std::stod(value.substr(comma + 1));
+            opt.customMix = true;
+        }
+        else { std::cout << "Nepoznata opcija: " << arg << std::endl; return false; }
+    }
+    return true;
+}
+
+static void printTimes(const char* label, const Histogram& h) {
+    std::cout << "  " << std::left << std::setw(14) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << mean(h) << std::setw(9) << percentile(h, 50) << std::setw(9) << percentile(h, 95)
+              << std::setw(9) << percentile(h, 99) << std::setw(9) << h.max << std::setw(10) << h.count << std::endl;
+}
+
+static void printRow(const char* label, int index, const ServiceTimes& t) {
+    std::cout << "  " << label << std::setw(5) << index << std::fixed << std::setprecision(1)
+              << std::setw(10) << mean(t.wait) << std::setw(9) << percentile(t.wait, 95) << std::setw(9) << t.wait.max
+              << std::setw(10) << mean(t.total) << std::setw(9) << percentile(t.total, 95) << std::setw(10) << t.wait.count << std::endl;
+}
+
+static void printReport(const Simulation& sim) {
+    std::cout << std::endl << "Vremena (s)         prosek      p50      p95      p99      max    putnika" << std::endl;
+    printTimes("cekanje", sim.stats.all.wait);
+    printTimes("voznja", sim.stats.all.journey);
+    printTimes("do odredista", sim.stats.all.total);
+
+    std::cout << std::endl << "Po polaznom spratu   cekanje      p95      max  do odred.      p95    putnika" << std::endl;
+    for (int f = 0; f < (int)sim.stats.byFloor.size(); f++) {
+        if (sim.stats.byFloor[f].wait.count) printRow("sprat", f, sim.stats.byFloor[f]);
+    }
+
+    std::cout << std::endl << "Po satu poziva       cekanje      p95      max  do odred.      p95    putnika" << std::endl;
+    for (int h = 0; h < (int)sim.stats.byHour.size(); h++) {
+        if (sim.stats.byHour[h].wait.count) printRow("sat  ", h, sim.stats.byHour[h]);
+    }
+
+    std::cout << std::endl << "Opterecenje kabina po satu (% nosivosti)" << std::endl;
+    for (int h = 0; h < HOURS_PER_DAY; h++) {
+        if (sim.metrics.observedTime[h] > 0.0) {
+            std::cout << "  sat  " << std::setw(5) << h << std::setw(10) << meanLoadFactor(sim, h) * 100.0 << std::endl;
+        }
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+// Jedna simulacija sa detaljnim izvestajem; false ako snimak scenario.start ne moze da se procita
+static bool runSingle(const Scenario& scenario, const std::string& save, int commuters) {
+    Simulation sim;
+    if (!initScenario(sim, scenario)) {
+        std::cout << "Neispravan snimak: " << scenario.start << std::endl;
+        return false;
+    }
+    CommuterStats commuterStats;
+    auto spawnStart = std::chrono::steady_clock::now();
+    spawnCommuters(sim, commuters, scenario.hours * 3600.0, scenario.seed ^ 0xC0FFEEull, commuterStats);
+    double spawnWall = std::chrono::duration<double>(std::chrono::steady_clock::now() - spawnStart).count();
+
+    double startTime = sim.time;
+    long long startEvents = sim.eventsProcessed;
+    auto start = std::chrono::steady_clock::now();
+    advanceTo(sim, startTime + scenario.hours * 3600.0);
+
+    auto end = std::chrono::steady_clock::now();
+    double wall = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Simulirano: " << (sim.time - startTime) / 3600.0 << " h (" << sim.eventsProcessed - startEvents << " dogadjaja)";
+    if (startTime > 0.0) std::cout << ", od " << startTime / 3600.0 << " h iz snimka";
+    std::cout << std::endl;
+    std::cout << "Kabina: " << sim.cars.size() << ", spratova: " << sim.floorCount
+              << ", dispecer: " << policyName(sim.policy) << std::endl;
+    std::cout << "Putnici: " << sim.metrics.passengers << " (uslo " << sim.metrics.boarded
+              << ", stiglo " << sim.metrics.delivered << "), pozivi sa spratova: " << sim.metrics.hallCalls << ", iz kabina: " << sim.metrics.carCalls << std::endl;
+    std::cout << "Zaustavljanja: " << sim.metrics.stopsServed
+              << ", usteda (prolazak pored poziva u suprotnom smeru): " << sim.metrics.stopsSaved << std::endl;
+    std::cout << "Nosivost: " << sim.cars[0].capacity << " putnika, prosecno opterecenje: " << meanLoadFactor(sim) * 100.0
+              << "%, nisu stali u kabinu: " << sim.metrics.leftBehind << std::endl;
+    std::cout << "Realno vreme: " << wall << " s (" << ((sim.time - startTime) / wall) << "x brze od realnog)" << std::endl;
+    printReport(sim);
+
+    if (commuters > 0) {
+        ScriptPoolStats pool = scriptPoolStats();
+        std::cout << std::endl << "Putnici-skripte: " << commuterStats.started << " krenulo, " << commuterStats.delivered
+                  << " stiglo, " << commuterStats.gaveUp << " odustalo, jos ceka " << pendingScripts(sim.scripts) << std::endl;
+        printTimes("cekanje", commuterStats.wait);
+        printTimes("do odredista", commuterStats.total);
+        std::cout << std::defaultfloat << std::setprecision(6);
+        std::cout << "Okviri korutina: " << pool.pooled << " iz bazena (" << pool.chunks << " blokova), "
+                  << pool.heap << " na heap-u, najvise zivih " << pool.peak
+                  << "; pokretanje: " << spawnWall * 1000.0 << " ms" << std::endl;
+    }
+
+    if (!save.empty()) {
+        if (saveSnapshot(save, sim)) std::cout << "Stanje sacuvano: " << save << std::endl;
+        else std::cout << "Ne mogu da sacuvam " << save << std::endl;
+    }
+    return true;
+}
+
+// Pravilo za merenje: ceo korak cita samo nizove iz BatchEnv
+static void ruleActions(const BatchEnv& env, std::vector<uint8_t>& actions) {
+    for (int i = 0; i < env.config.instances; i++) {
+        uint64_t calls = env.carCalls[i] | env.hallUp[i] | env.hallDown[i];
+        int f = env.floor[i];
+        if (calls == 0) actions[i] = BATCH_WAIT;
+        else if (calls & (1ull << f)) actions[i] = BATCH_OPEN;
+        else {
+            uint64_t above = calls & ~((2ull << f) - 1);
+            uint64_t below = calls & ((1ull << f) - 1);
+            int up = above ? std::countr_zero(above) - f : 64;
+            int down = below ? f - (63 - std::countl_zero(below)) : 64;
+            actions[i] = (up <= down) ? BATCH_UP : BATCH_DOWN;
+        }
+    }
+}
+
+static void runBatch(const Options& opt) {
+    BatchConfig config;
+    config.instances = opt.batch;
+    config.floors = opt.grid.base.floors;
+    config.arrivalRate = opt.rate;
+    config.seed = opt.grid.seeds.empty() ? 1 : opt.grid.seeds[0];
+    config.motion = opt.grid.base.motion;
+
+    BatchEnv env;
+    const std::string& from = opt.grid.base.start;
+    if (from.empty()) {
+        initBatch(env, config);
+    }
+    else {
+        auto loadStart = std::chrono::steady_clock::now();
+        if (!loadSnapshot(from, env)) { std::cout << "Neispravan snimak: " << from << std::endl; return; }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+        config = env.config;
+        std::cout << "Ucitano " << config.instances << " zgrada iz " << from << " za " << ms << " ms" << std::endl;
+    }
+    std::vector<uint8_t> actions(config.instances);
+
+    double rewardSum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < opt.batchSteps; s++) {
+        ruleActions(env, actions);
+        stepBatch(env, actions.data());
+        for (float r : env.reward) rewardSum += r;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double envSteps = (double)opt.batchSteps * config.instances;
+    std::cout << "Zgrada: " << config.instances << ", koraka: " << opt.batchSteps << std::endl;
+    std::cout << "Prosecna nagrada po koraku: " << rewardSum / envSteps << std::endl;
+    std::cout << "Realno vreme: " << wall << " s (" << envSteps / wall / 1e6 << " M koraka okruzenja u sekundi)" << std::endl;
+
+    if (!opt.save.empty()) {
+        if (saveSnapshot(opt.save, env)) std::cout << "Stanje sacuvano: " << opt.save << std::endl;
+        else std::cout << "Ne mogu da sacuvam " << opt.save << std::endl;
+    }
+}
+
+// Vraca false ako se neki otisak ne poklapa (ili snimak ne moze da se procita)
+static bool runReplay(const Options& opt) {
+    InputLogHeader header;
+    std::vector<InputRecord> records;
+    if (!loadInputLog(opt.replay, header, records)) {
+        std::cout << "Neispravan snimak: " << opt.replay << std::endl;
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    ReplayResult result = replayInputLog(header, records);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Spratova: " << header.floors << ", kabina: " << header.cars << ", seed: " << header.seed << std::endl;
+    std::cout << "Koraka: " << result.ticks << " (" << result.ticks * SIM_DT << " s), ulaza: " << result.inputs
+              << ", otisaka: " << result.hashesChecked << std::endl;
+    std::cout << "Zavrsni otisak: " << std::hex << result.finalHash << std::dec << std::endl;
+    std::cout << "Realno vreme: " << wall << " s" << std::endl;
+    if (result.firstMismatch >= 0) {
+        std::cout << "RAZLIKA: stanje se razilazi od koraka " << result.firstMismatch << std::endl;
+        return false;
+    }
+    std::cout << "Stanje se poklapa sa snimkom." << std::endl;
+    return true;
+}
+
+// --- PROVERE ---
+
+// Kabina miruje na 2. spratu, poslednji smer GORE, a jedini poziv je DOLE sa
+// tog istog sprata: mora da se okrene, otvori i preveze putnika
+static bool checkOppositeCallHere(DispatchPolicy policy) {
+    Simulation sim;
+    initSimulation(sim, 8, 1, 2);
+    sim.policy = policy;
+    sim.cars[0].lastDirection = 1;
+
+    Passenger p;
+    p.origin = 2;
+    p.destination = 0;
+    addPassenger(sim, p);
+    runSimulation(sim, 120.0);
+    return sim.metrics.delivered == 1 && !sim.hallDown.test(2);
+}
+
+// Jutarnja spica sa malim kabinama, koje se cesto pune: kabina sme da vodi
+// poziv sa sprata samo dok joj je dodeljen (puna kabina ga predaje drugoj)
+static bool checkFullCarHandover(DispatchPolicy policy) {
+    Simulation sim;
+    initSimulation(sim, 10, 3, 2);
+    sim.policy = policy;
+    setCapacity(sim, 4);
+    startTraffic(sim, trafficMix(TRAFFIC_UP_PEAK, 600.0), 5);
+    for (int second = 1; second <= 3600; second++) {
+        advanceTo(sim, second);
+        for (int c = 0; c < (int)sim.cars.size(); c++) {
+            for (int f = 0; f < sim.floorCount; f++) {
+                if (sim.cars[c].hallUp.test(f) && sim.upAssignment[f] != c) return false;
+                if (sim.cars[c].hallDown.test(f) && sim.downAssignment[f] != c) return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool reportCheck(const char* name, DispatchPolicy policy, bool passed) {
+    std::cout << name << " (" << policyName(policy) << "): " << (passed ? "OK" : "GRESKA") << std::endl;
+    return passed;
+}
+
+static bool runChecks() {
+    bool ok = true;
+    for (DispatchPolicy policy : { DISPATCH_SCAN, DISPATCH_LOOK, DISPATCH_NEAREST, DISPATCH_ETA }) {
+        ok &= reportCheck("Poziv u suprotnom smeru na spratu kabine", policy, checkOppositeCallHere(policy));
+        ok &= reportCheck("Puna kabina predaje pozive sa spratova", policy, checkFullCarHandover(policy));
+    }
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) return 1;
+
+    if (!opt.replay.empty()) return runReplay(opt) ? 0 : 1;
+    if (opt.check) return runChecks() ? 0 : 1;
+
+    TrafficMix mix = trafficMix(opt.traffic, opt.rate);
+    if (opt.customMix) {
+        mix.incoming = opt.incoming;
+        mix.outgoing = opt.outgoing;
+        mix.interfloor = 1.0 - opt.incoming - opt.outgoing;
+    }
+    opt.grid.base.traffic = mix;
+
+    if (opt.batch > 0) {
+        runBatch(opt);
+        return 0;
+    }
+
+    // Zgrada iz snimka odredjuje spratove i kabine (i u CSV-u)
+    if (!opt.grid.base.start.empty()) {
+        Simulation warm;
+        if (!loadSnapshot(opt.grid.base.start, warm)) { std::cout << "Neispravan snimak: " << opt.grid.base.start << std::endl; return 1; }
+        opt.grid.base.floors = warm.floorCount;
+        opt.grid.base.cars = (int)warm.cars.size();
+        if (!opt.grid.cars.empty()) std::cout << "--cars se zanemaruje: kabine su iz snimka" << std::endl;
+        opt.grid.cars.clear();
+    }
+
+    std::vector<Scenario> scenarios = expandGrid(opt.grid);
+    if (scenarios.size() == 1 && !opt.sweep) {
+        return runSingle(scenarios[0], opt.save, opt.commuters) ? 0 : 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ScenarioResult> results = runSweep(scenarios, opt.threads);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (opt.out.empty()) {
+        writeSweepCsv(std::cout, results);
+    }
+    else {
+        std::ofstream file(opt.out);
+        if (!file) { std::cerr << "Ne mogu da otvorim " << opt.out << std::endl; return 1; }
+        writeSweepCsv(file, results);
+    }
+    std::cerr << "Kombinacija: " << results.size() << ", realno vreme: " << wall << " s" << std::endl;
+
+    // Snimak je mogao da nestane ili da se promeni posle provere iznad
+    size_t failed = 0;
+    for (const ScenarioResult& r : results) failed += !r.ok;
+    if (failed > 0) {
+        std::cerr << "Neispravan snimak " << opt.grid.base.start << ": " << failed << " kombinacija nije pokrenuto (nema ih u CSV-u)" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -9,48 +9,23 @@
 #include <cmath>
 #include <fstream>
 #include <sstream>
+#include <cstring>
+#include <cstddef>
 
-// --- GLOBALE ZA REZOLUCIJU ---
-float WINDOW_WIDTH = 800.0f;
-float WINDOW_HEIGHT = 600.0f;
-float PANEL_WIDTH = 0;
+#include "SimThread.h"
+#include "StrokeFont.h"
 
-enum LiftState { IDLE, MOVING_UP, MOVING_DOWN, DOOR_OPENING, DOOR_OPEN, DOOR_CLOSING };
-
-struct Button {
-    float x, y, w, h;
-    std::string label;
-    bool isPressed;
-    int floorIndex;
-    int actionType; // 0=sprat, 1=otv, 2=zat, 3=stop, 4=vent
-};
-
-// Globalne promenljive
-std::string floorNames[8] = { "SU", "PR", "1", "2", "3", "4", "5", "6" };
-float liftY = 0;
-int currentFloor = 2; // Krece sa 1. sprata (indeks 2)
+// Stanje lifta, osobe i dugmadi zivi u App-u na niti simulacije (SimThread.h);
+// prozor crta poslednji objavljeni FrameState i niti salje ulaz
+const char* GUI_INPUT_LOG = "lift_input.rec";
+const char* GUI_SNAPSHOT = "lift_state.snap"; // F5: snimak stanja (LiftSim --start)
+const int GUI_TICKS_PER_WAKE = 1;   // Kretanje se interpolira, pa nit moze da se budi i redje
+SimThread simThread;
 
 // Globalne promenljive za dimenzije slike lifta
 int liftImgWidth = 0;
 int liftImgHeight = 0;
 
-// Osoba
-float personX = 0;
-float personY = 0;
-bool personInLift = false;
-
-LiftState liftState = IDLE;
-float doorHeight = 0.0f;
-float MAX_DOOR_HEIGHT = 0.0f;
-
-double doorOpenTimeStart = 0;
-bool extendedOnce = false;
-const double DOOR_DURATION = 5.0; // 5 sekundi
-bool ventilationOn = false;
-
-std::vector<Button> buttons;
-bool floorRequests[8] = { false };
-
 // Teksture
 unsigned int buildingTexture;
 unsigned int liftTexture;
@@ -60,23 +35,12 @@ unsigned int personTexture;
 int personImgWidth, personImgHeight;
 
 // --- POMOCNE FUNKCIJE ---
-// 
-// Vraca X koordinatu gde lift vizuelno pocinje (za detekciju ulaska)
-float getLiftVisualX() {
-    float buildingWidth = WINDOW_WIDTH * 0.3f;
-    float buildingX = WINDOW_WIDTH - buildingWidth;
-    float liftW = buildingWidth * 0.8f;
-    float liftX = buildingX + (buildingWidth * 0.1f);
-    return liftX;
-}
-
-// --- POMOCNA FUNKCIJA ZA DIMENZIJE ---
-float getFloorH() { return WINDOW_HEIGHT / 8.0f; }
 
 // Vraca X koordinatu i Sirinu lifta (ZALEPLJEN DESNO + PROPORCIONALAN)
-void getLiftDimensions(float& outX, float& outW) {
+// Kabina 0 je skroz desno, svaka sledeca ima svoje okno levo od prethodne
+void getLiftDimensions(const FrameState& f, int car, float& outX, float& outW) {
     // 1. Racunamo visinu lifta
-    float fh = getFloorH();
+    float fh = f.height / (float)f.floorCount;
     float liftH = fh * 0.9f;
 
     // 2. Racunamo sirinu na osnovu originalne slike 
@@ -88,8 +52,8 @@ void getLiftDimensions(float& outX, float& outW) {
         outW = 100.0f; // Sigurnosna vrednost ako slika nije ucitana
     }
 
-    // 3. Pozicija X: Skroz desno (Sirina prozora - Sirina lifta)
-    outX = WINDOW_WIDTH - outW;
+    // 3. Pozicija X: Skroz desno (Sirina prozora - Sirina lifta), pa okno po okno ulevo
+    outX = f.width - (car + 1) * outW;
 }
 
 // --- TEXTURE LOADER ---
@@ -167,380 +131,333 @@ unsigned int createShader(const char* vertexPath, const char* fragmentPath) {
     return ID;
 }
 
-// --- VECTOR FONT ---
-void appendChar(std::vector<float>& vertices, char c, float x, float y, float s) {
-    auto addLine = [&](float x1, float y1, float x2, float y2) {
-        vertices.push_back(x + x1 * s); vertices.push_back(y + y1 * s);
-        vertices.push_back(x + x2 * s); vertices.push_back(y + y2 * s);
-        };
-    switch (toupper(c)) {
-    case '0': addLine(0, 0, 1, 0); addLine(1, 0, 1, 2); addLine(1, 2, 0, 2); addLine(0, 2, 0, 0); break;
-    case '1': addLine(0.5, 0, 0.5, 2); break;
-    case '2': addLine(0, 2, 1, 2); addLine(1, 2, 1, 1); addLine(1, 1, 0, 1); addLine(0, 1, 0, 0); addLine(0, 0, 1, 0); break;
-    case '3': addLine(0, 2, 1, 2); addLine(1, 2, 1, 0); addLine(1, 0, 0, 0); addLine(0, 1, 1, 1); break;
-    case '4': addLine(0, 2, 0, 1); addLine(0, 1, 1, 1); addLine(1, 0, 1, 2); break;
-    case '5': addLine(1, 2, 0, 2); addLine(0, 2, 0, 1); addLine(0, 1, 1, 1); addLine(1, 1, 1, 0); addLine(1, 0, 0, 0); break;
-    case '6': addLine(1, 2, 0, 2); addLine(0, 2, 0, 0); addLine(0, 0, 1, 0); addLine(1, 0, 1, 1); addLine(1, 1, 0, 1); break;
-    case '7': addLine(0, 2, 1, 2); addLine(1, 2, 0.5, 0); break; 
-    case '8': addLine(0, 0, 1, 0); addLine(1, 0, 1, 2); addLine(1, 2, 0, 2); addLine(0, 2, 0, 0); addLine(0, 1, 1, 1); break; 
-
-        // SLOVA
-    case 'A': addLine(0, 0, 0, 2); addLine(0, 2, 1, 2); addLine(1, 2, 1, 0); addLine(0, 1, 1, 1); break;
-    case 'B': addLine(0, 0, 0, 2); addLine(0, 2, 0.8, 2); addLine(0.8, 2, 1, 1.5); addLine(1, 1.5, 0.8, 1); addLine(0.8, 1, 0, 1); addLine(0.8, 1, 1, 0.5); addLine(1, 0.5, 0.8, 0); addLine(0.8, 0, 0, 0); break;
-    case 'C': addLine(1, 2, 0, 2); addLine(0, 2, 0, 0); addLine(0, 0, 1, 0); break;
-    case 'D': addLine(0, 0, 0, 2); addLine(0, 2, 0.6, 2); addLine(0.6, 2, 1, 1); addLine(1, 1, 0.6, 0); addLine(0.6, 0, 0, 0); break; 
-    case 'E': addLine(1, 0, 0, 0); addLine(0, 0, 0, 2); addLine(0, 2, 1, 2); addLine(0, 1, 1, 1); break;
-    case 'F': addLine(0, 0, 0, 2); addLine(0, 2, 1, 2); addLine(0, 1, 1, 1); break;
-    case 'G': addLine(1, 2, 0, 2); addLine(0, 2, 0, 0); addLine(0, 0, 1, 0); addLine(1, 0, 1, 1); break;
-    case 'I': addLine(0.5, 0, 0.5, 2); addLine(0, 0, 1, 0); addLine(0, 2, 1, 2); break; 
-    case 'L': addLine(0, 2, 0, 0); addLine(0, 0, 1, 0); break;
-    case 'M': addLine(0, 0, 0, 2); addLine(0, 2, 0.5, 1); addLine(0.5, 1, 1, 2); addLine(1, 2, 1, 0); break;
-    case 'N': addLine(0, 0, 0, 2); addLine(0, 2, 1, 0); addLine(1, 0, 1, 2); break;
-    case 'O': addLine(0, 0, 1, 0); addLine(1, 0, 1, 2); addLine(1, 2, 0, 2); addLine(0, 2, 0, 0); break;
-    case 'P': addLine(0, 0, 0, 2); addLine(0, 2, 1, 2); addLine(1, 2, 1, 1); addLine(1, 1, 0, 1); break;
-    case 'R': addLine(0, 0, 0, 2); addLine(0, 2, 1, 2); addLine(1, 2, 1, 1); addLine(0, 1, 1, 0); addLine(0.5, 1, 1, 0); break; 
-    case 'S': addLine(1, 2, 0, 2); addLine(0, 2, 0, 1); addLine(0, 1, 1, 1); addLine(1, 1, 1, 0); addLine(1, 0, 0, 0); break;
-    case 'T': addLine(0.5, 0, 0.5, 2); addLine(0, 2, 1, 2); break;
-    case 'U': addLine(0, 2, 0, 0); addLine(0, 0, 1, 0); addLine(1, 0, 1, 2); break;
-    case 'V': addLine(0, 2, 0.5, 0); addLine(0.5, 0, 1, 2); break;
-    case 'Z': addLine(0, 2, 1, 2); addLine(1, 2, 0, 0); addLine(0, 0, 1, 0); break;
-    case '/': addLine(0, 0, 1, 2); break;
-    case ' ': break; 
-    }
+// --- STRIMOVANJE GEOMETRIJE ---
+// Sva geometrija koja se menja svakog frejma (pravougaonici, okviri dugmadi,
+// kursor) pise se u jedan prsten bafer od STREAM_SECTIONS delova, po jedan
+// deo za frejm. Deo se ponovo puni tek kad GPU zavrsi frejm koji ga je citao
+// (ograda, glFenceSync), pa upis ne ceka drajver i bafer se ne realocira iz
+// frejma u frejm. Sa ARB_buffer_storage (GL 4.4) bafer je trajno mapiran;
+// inace se svaki upis mapira bez sinhronizacije (GL_MAP_UNSYNCHRONIZED_BIT),
+// sto je bezbedno zbog istih ograda.
+const int STREAM_SECTIONS = 3;                  // Frejmova koje GPU moze da crta dok pisemo sledeci
+const size_t STREAM_MIN_SECTION = 256 * 1024;   // Pocetna velicina dela (bajtova); raste po potrebi
+const size_t STREAM_ALIGN = 16;
+
+struct StreamBuffer {
+    unsigned int buffer = 0;
+    size_t sectionSize = 0;
+    int section = 0;                    // Deo u koji pise tekuci frejm
+    size_t used = 0;                    // Zauzeto u tom delu
+    char* mapped = nullptr;             // Ceo bafer, ako je trajno mapiran
+    GLsync fences[STREAM_SECTIONS] = {};
+};
+
+// Gde je upis zavrsio: bafer i pomeraj u bajtovima (za glVertexAttribPointer)
+struct StreamSpan {
+    unsigned int buffer = 0;
+    size_t offset = 0;
+};
+
+// Koliko upis od bytes bajtova zauzima u delu (sa poravnanjem)
+size_t streamBytes(size_t bytes) {
+    return (bytes + STREAM_ALIGN - 1) / STREAM_ALIGN * STREAM_ALIGN;
 }
 
-// --- INIT LOGIC ---
-void initLogic() {
-    buttons.clear();
-    PANEL_WIDTH = WINDOW_WIDTH * 0.35f;
-
-    float panelCenterX = PANEL_WIDTH / 2.0f;
-    float startY = WINDOW_HEIGHT * 0.8f;
-    float btnW = PANEL_WIDTH * 0.3f;
-    float btnH = WINDOW_HEIGHT * 0.06f;
-    float gapX = btnW * 0.2f;
-    float gapY = btnH * 0.5f;
-
-    // --- SPRATOVI ---
-    for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 2; col++) {
-            int logicIndex = 7 - (row * 2 + col);
-            Button b;
-            if (col == 0) b.x = panelCenterX - btnW - (gapX / 2);
-            else          b.x = panelCenterX + (gapX / 2);
-            b.y = startY - row * (btnH + gapY);
-            b.w = btnW; b.h = btnH;
-            b.label = floorNames[logicIndex];
-            b.isPressed = floorRequests[logicIndex];
-            b.floorIndex = logicIndex;
-            b.actionType = 0;
-            buttons.push_back(b);
-        }
+void initStreamBuffer(StreamBuffer& sb, size_t sectionSize) {
+    sb.sectionSize = sectionSize;
+    sb.section = 0;
+    sb.used = 0;
+    size_t total = sectionSize * STREAM_SECTIONS;
+    glGenBuffers(1, &sb.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, sb.buffer);
+    if (GLEW_ARB_buffer_storage) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, total, NULL, flags);
+        sb.mapped = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, total, flags);
     }
-
-    // --- SPECIJALNI TASTERI ---
-    float specStartY = WINDOW_HEIGHT * 0.3f;
-    std::string specs[] = { "OTVORI", "ZATVORI", "STOP", "VENT" };
-    for (int i = 0; i < 4; i++) {
-        Button b;
-        if (i % 2 == 0) b.x = panelCenterX - btnW - (gapX / 2);
-        else            b.x = panelCenterX + (gapX / 2);
-        b.y = specStartY - (i / 2) * (btnH + gapY);
-        b.w = btnW; b.h = btnH;
-        b.label = specs[i];
-        b.isPressed = false;
-        b.floorIndex = -1;
-        b.actionType = i + 1;
-        buttons.push_back(b);
+    else {
+        glBufferData(GL_ARRAY_BUFFER, total, NULL, GL_STREAM_DRAW);
+        sb.mapped = nullptr;
     }
+}
 
-    // Inicijalizacija POZICIJA 
-    static bool firstRun = true;
-    if (firstRun) {
-        float floorHeight = WINDOW_HEIGHT / 8.0f;
-
-        currentFloor = 2;
-        liftY = 2 * floorHeight;
-        personY = 1 * floorHeight;
+void waitStreamFence(GLsync& fence) {
+    if (!fence) return;
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+    glDeleteSync(fence);
+    fence = 0;
+}
 
-        //  Racunamo gde pocinje zgrada (30% sirine s desna)
-        float buildingWidth = WINDOW_WIDTH * 0.3f;
-        float buildingStart = WINDOW_WIDTH - buildingWidth;
+// Pocetak frejma: sledeci deo, kad ga GPU oslobodi. bytes je zbir streamBytes
+// svih upisa u ovom frejmu; ako ne staje, prsten se pravi ponovo (duplo veci)
+void beginStreamFrame(StreamBuffer& sb, size_t bytes) {
+    if (bytes > sb.sectionSize) {
+        for (GLsync& fence : sb.fences) waitStreamFence(fence);
+        glBindBuffer(GL_ARRAY_BUFFER, sb.buffer);
+        if (sb.mapped) glUnmapBuffer(GL_ARRAY_BUFFER);
+        glDeleteBuffers(1, &sb.buffer);
+        size_t size = sb.sectionSize * 2;
+        while (size < bytes) size *= 2;
+        initStreamBuffer(sb, size);
+        return;
+    }
+    sb.section = (sb.section + 1) % STREAM_SECTIONS;
+    sb.used = 0;
+    waitStreamFence(sb.fences[sb.section]);
+}
 
-        personX = buildingStart; //  Krece tacno od leve ivice zgrade
+StreamSpan streamWrite(StreamBuffer& sb, const void* data, size_t bytes) {
+    StreamSpan span;
+    span.buffer = sb.buffer;
+    span.offset = sb.section * sb.sectionSize + sb.used;
+    sb.used += streamBytes(bytes);
+    if (bytes == 0) return span;
 
-        personInLift = false;
-        firstRun = false;
+    if (sb.mapped) {
+        memcpy(sb.mapped + span.offset, data, bytes);
+    }
+    else {
+        glBindBuffer(GL_ARRAY_BUFFER, sb.buffer);
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+        void* dst = glMapBufferRange(GL_ARRAY_BUFFER, span.offset, bytes, flags);
+        if (dst) {
+            memcpy(dst, data, bytes);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
     }
-    MAX_DOOR_HEIGHT = (WINDOW_HEIGHT / 8.0f) * 0.9f;
+    return span;
 }
 
-//void checkRequests() {
-//    if (liftState != IDLE) return;
-//    int target = -1;
-//    int minDistance = 100;
-//
-//    // Trazimo najblizi sprat koji je pozvan
-//    for (int i = 0; i < 8; i++) {
-//        if (floorRequests[i]) {
-//            int dist = abs(i - currentFloor);
-//            if (dist < minDistance) { minDistance = dist; target = i; }
-//        }
-//    }
-//
-//    if (target != -1) {
-//        if (target > currentFloor) liftState = MOVING_UP;
-//        else if (target < currentFloor) liftState = MOVING_DOWN;
-//        else {
-//            // Ako smo vec tu, otvori vrata
-//            floorRequests[target] = false;
-//            liftState = DOOR_OPENING;
-//            if (ventilationOn) ventilationOn = false;
-//        }
-//    }
-//}
-
-void checkRequests() {
-    if (liftState != IDLE) return;
-
-    // Pamtimo smer kretanja: 1 = GORE, -1 = DOLE
-    // "static" znaci da ova promenljiva cuva vrednost izmedju poziva funkcije
-    static int lastDirection = 1;
-
-    // --- 1. PROVERA: Da li je pozvan na TRENUTNOM spratu? ---
-    if (floorRequests[currentFloor]) {
-        floorRequests[currentFloor] = false;
-        liftState = DOOR_OPENING;
-        if (ventilationOn) ventilationOn = false;
-        return;
-    }
+// Kraj frejma: deo se ne dira dok GPU ne prodje sve do ovde
+void endStreamFrame(StreamBuffer& sb) {
+    sb.fences[sb.section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
 
-    // --- 2. LOGIKA KRETANJA (SCAN ALGORITAM) ---
+// Linije (vec2 po verteksu) iz prstena; VAO_Line mora biti vezan
+void drawStreamLines(const StreamSpan& span, size_t first, size_t count) {
+    if (count == 0) return;
+    glBindBuffer(GL_ARRAY_BUFFER, span.buffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)span.offset);
+    glDrawArrays(GL_LINES, (GLint)first, (GLsizei)count);
+}
 
-    bool requestFound = false;
+// --- PRAVOUGAONICI (INSTANCE) ---
+// Jednobojni pravougaonici frejma skupljaju se po slojevima, salju jednom po
+// frejmu kao niz instanci (x, y, w, h, boja) i svaki sloj je jedan
+// glDrawArraysInstanced nad jedinicnim kvadratom (rect.vert)
+struct RectInstance {
+    float x, y, w, h;
+    float r, g, b, a;
+};
 
-    // A) Ako smo isli GORE (ili stojimo), prvo gledamo ima li sta IZNAD
-    if (lastDirection == 1) {
-        for (int i = currentFloor + 1; i < 8; i++) {
-            if (floorRequests[i]) {
-                liftState = MOVING_UP;
-                requestFound = true;
-                return; // Nastavljamo gore
-            }
-        }
+// Slojevi redom crtanja; izmedju njih idu teksture i linije
+enum RectLayer {
+    LAYER_BACKGROUND,   // Asfalt, panel, pozadina dugmadi
+    LAYER_BUTTON_FILL,  // Unutrasnjost dugmadi (preko okvira)
+    LAYER_SHAFTS,       // Okna (preko zgrade)
+    LAYER_PASSENGERS,   // Putnici (preko kabina)
+    LAYER_DOORS,        // Vrata (preko osobe)
+    RECT_LAYER_COUNT
+};
 
-        // Ako nema nista gore, trazimo ima li sta DOLE
-        if (!requestFound) {
-            for (int i = currentFloor - 1; i >= 0; i--) {
-                if (floorRequests[i]) {
-                    liftState = MOVING_DOWN;
-                    lastDirection = -1; // Menjamo smer pamcenja u DOLE
-                    return;
-                }
-            }
-        }
-    }
+struct RectBatch {
+    std::vector<RectInstance> layers[RECT_LAYER_COUNT];
+    std::vector<RectInstance> all;          // Svi slojevi redom, kako se salju
+    size_t first[RECT_LAYER_COUNT] = {};    // Pocetak sloja u all
+};
 
-    // B) Ako smo isli DOLE, prvo gledamo ima li sta ISPOD
-    else {
-        for (int i = currentFloor - 1; i >= 0; i--) {
-            if (floorRequests[i]) {
-                liftState = MOVING_DOWN;
-                requestFound = true;
-                return; // Nastavljamo dole
-            }
-        }
+void clearRects(RectBatch& batch) {
+    for (std::vector<RectInstance>& layer : batch.layers) layer.clear();
+}
 
-        // Ako nema nista dole, trazimo ima li sta GORE
-        if (!requestFound) {
-            for (int i = currentFloor + 1; i < 8; i++) {
-                if (floorRequests[i]) {
-                    liftState = MOVING_UP;
-                    lastDirection = 1; // Menjamo smer pamcenja u GORE
-                    return;
-                }
-            }
-        }
-    }
+void addRect(RectBatch& batch, RectLayer layer, float x, float y, float w, float h, float r, float g, float b, float a) {
+    batch.layers[layer].push_back(RectInstance{ x, y, w, h, r, g, b, a });
 }
 
-void updateApp() {
-    float fh = getFloorH();
-    float speed = fh * 0.02f; // Brzina kretanja
-
-    if (liftState == MOVING_UP) {
-        liftY += speed;
-        if (liftY >= (currentFloor + 1) * fh) {
-            currentFloor++;
-            if (floorRequests[currentFloor]) {
-                liftState = DOOR_OPENING;
-                floorRequests[currentFloor] = false;
-                if (ventilationOn) ventilationOn = false;
-            }
-            else { checkRequests(); if (liftState == IDLE) liftState = MOVING_DOWN; }
-        }
-    }
-    else if (liftState == MOVING_DOWN) {
-        liftY -= speed;
-        if (liftY <= (currentFloor - 1) * fh) {
-            currentFloor--;
-            if (floorRequests[currentFloor]) {
-                liftState = DOOR_OPENING;
-                floorRequests[currentFloor] = false;
-                if (ventilationOn) ventilationOn = false;
-            }
-            else { checkRequests(); }
-        }
+// Svi slojevi redom u batch.all (tako idu u bafer instanci)
+void packRects(RectBatch& batch) {
+    batch.all.clear();
+    for (int i = 0; i < RECT_LAYER_COUNT; i++) {
+        batch.first[i] = batch.all.size();
+        batch.all.insert(batch.all.end(), batch.layers[i].begin(), batch.layers[i].end());
     }
+}
 
-    // Logika Vrata
-    if (liftState == DOOR_OPENING) {
-        doorHeight += speed * 0.5f;
+// Jedan sloj jednim pozivom; program rect i njegov VAO moraju biti vezani.
+// span je mesto gde je batch.all upisan u bafer (StreamBuffer)
+void drawRectLayer(const RectBatch& batch, RectLayer layer, const StreamSpan& span) {
+    GLsizei count = (GLsizei)batch.layers[layer].size();
+    if (count == 0) return;
+    size_t offset = span.offset + batch.first[layer] * sizeof(RectInstance);
+    glBindBuffer(GL_ARRAY_BUFFER, span.buffer);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(RectInstance), (void*)offset);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(RectInstance), (void*)(offset + 4 * sizeof(float)));
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+}
 
-        if (doorHeight >= MAX_DOOR_HEIGHT) {
-            doorHeight = MAX_DOOR_HEIGHT;
-            liftState = DOOR_OPEN;
-            doorOpenTimeStart = glfwGetTime(); // Poni merenje 5s
+// Okvir dugmeta kao cetiri duzi (GL_LINES)
+void appendOutline(std::vector<float>& vertices, const Button& b) {
+    float x0 = b.x, y0 = b.y, x1 = b.x + b.w, y1 = b.y + b.h;
+    float segments[] = { x0, y0, x1, y0,  x1, y0, x1, y1,  x1, y1, x0, y1,  x0, y1, x0, y0 };
+    vertices.insert(vertices.end(), segments, segments + 16);
+}
 
-            extendedOnce = false; // Resetujemo opciju za produenje
+// --- TEKST (KES) ---
+// Natpisi (spratovi, dugmad, ime i indeks) zavise samo od rasporeda, pa se
+// grade jednom u staticke bafere i ponovo tek kad nit objavi nov raspored
+// (FrameState::layoutVersion). Svaki frejm je onda jedan poziv crtanja.
+//
+// Dva nacina (F6 menja): atlas sa udaljenostima (SDF, StrokeFont.h), gde je
+// svaki znak jedan cetvorougao (instanca) i debljina poteza prati velicinu
+// slova, i stari vektorski font kao GL_LINES, sa debljinom linije koju
+// odredi drajver.
+bool atlasText = true;
+
+struct TextCache {
+    unsigned int lineVao = 0;
+    unsigned int lineBuffer = 0;
+    GLsizei lineVertexCount = 0;
+
+    unsigned int quadVao = 0;
+    unsigned int quadBuffer = 0;        // GlyphQuad po znaku
+    GLsizei quadCount = 0;
+
+    unsigned int layoutVersion = 0;     // Raspored po kome su baferi izgradjeni
+    bool built = false;
+
+    // Radni prostor za gradnju
+    std::vector<std::string> floorNames;
+    std::vector<StrokeLabel> labels;
+    std::vector<float> lines;
+    std::vector<GlyphQuad> quads;
+};
 
-            // Kad se vrata otvore, zahtev je ispunjen, gasimo lampicu
-            if (currentFloor >= 0 && currentFloor < 8) {
-                floorRequests[currentFloor] = false;
-            }
-        }
-    }
-    else if (liftState == DOOR_CLOSING) {
-        doorHeight -= speed * 0.5f;
-        if (doorHeight <= 0) {
-            doorHeight = 0;
-            liftState = IDLE;
-            checkRequests(); // Kad se zatvore, vidi gde dalje
-        }
-    }
-    else if (liftState == DOOR_OPEN) {
-        // Ceka 5 sekundi
-        if (glfwGetTime() - doorOpenTimeStart > DOOR_DURATION) {
-            liftState = DOOR_CLOSING;
-        }
-    }
+// unitQuad: jedinicni kvadrat (6 verteksa) koji deli sa pravougaonicima
+void initTextCache(TextCache& text, unsigned int unitQuad) {
+    glGenVertexArrays(1, &text.lineVao);
+    glGenBuffers(1, &text.lineBuffer);
+    glBindVertexArray(text.lineVao);
+    glBindBuffer(GL_ARRAY_BUFFER, text.lineBuffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
 
-    // Ako je osoba u liftu, njena Y koordinata je uvek fiksirana za liftY
-    if (personInLift) {
-        personY = liftY + 5; // +5 da ne propadne kroz pod
+    glGenVertexArrays(1, &text.quadVao);
+    glGenBuffers(1, &text.quadBuffer);
+    glBindVertexArray(text.quadVao);
+    glBindBuffer(GL_ARRAY_BUFFER, unitQuad);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, text.quadBuffer);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(GlyphQuad), (void*)offsetof(GlyphQuad, x));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(GlyphQuad), (void*)offsetof(GlyphQuad, u0));
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(GlyphQuad), (void*)offsetof(GlyphQuad, pxRange));
+    for (int i = 1; i <= 3; i++) {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
     }
 }
 
-// --- INPUTS (Tastatura) ---
-void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-    if (action == GLFW_PRESS || action == GLFW_REPEAT) {
-        float moveSpeed = 10.0f;
+// Atlas znakova kao tekstura (pravi se pri pokretanju, par milisekundi)
+unsigned int createAtlasTexture(const StrokeAtlas& atlas) {
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlas.width, atlas.height, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.distance.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return textureID;
+}
 
-        // 1. OSOBA JE VAN LIFTA
-        if (!personInLift) {
-            if (key == GLFW_KEY_A) { // Levo
-                personX -= moveSpeed;
+// Svi natpisi za raspored iz f
+void buildTextLabels(const FrameState& f, std::vector<std::string>& floorNames, std::vector<StrokeLabel>& labels) {
+    float buildingX = f.width - f.width * 0.3f;
+    float fh = f.height / (float)f.floorCount;
 
-                // Racunamo granicu zgrade
-                float buildingStart = WINDOW_WIDTH - (WINDOW_WIDTH * 0.3f);
+    floorNames.resize(f.floorCount);     // Natpisi pokazuju u ove stringove (i u f.buttons)
+    labels.clear();
+    labels.reserve(f.floorCount + f.buttons.size() + 2);
 
-                // Ne dozvoljavamo da ode levo od pocetka zgrade
-                if (personX < buildingStart) personX = buildingStart;
-            }
-            if (key == GLFW_KEY_W) { // Desno
-                personX += moveSpeed;
-
-                // === LOGIKA ULAZKA U LIFT (W) ===
-                float liftStartX = getLiftVisualX();
-                // Ako predjemo prag lifta DOK su vrata otvorena i lift je na nasem spratu
-                if (personX >= liftStartX && liftState == DOOR_OPEN) {
-                    int personFloor = (int)(personY / getFloorH());
-                    if (personFloor == currentFloor) {
-                        personInLift = true; // <--- OSOBA ULAZI
-                        std::cout << "Usao u lift!" << std::endl;
-                    }
-                }
-
-                // Granica je 90% sirine ekrana
-                if (personX > WINDOW_WIDTH * 0.92f) personX = WINDOW_WIDTH * 0.92f;
-            }
+    // A) Linije za spratove
+    for (int i = 0; i < f.floorCount; i++) {
+        floorNames[i] = floorName(i);
+        float y = i * fh;
+        labels.push_back(StrokeLabel{ floorNames[i], buildingX - 30, y + fh / 2 - 5, fh * 0.08f, fh * 0.13f });
+    }
 
-            // === LOGIKA POZIVANJA LIFTA (C) ===
-            if (key == GLFW_KEY_C && personX >= (WINDOW_WIDTH * 0.92f)) {
+    // B) Tekst na dugmadima
+    for (const Button& b : f.buttons) {
+        float charSize = b.h * 0.15f;
+        float textLen = b.label.length() * (charSize + 6.0f);
+        float tx = b.x + (b.w - textLen) / 2 + 5;
+        float ty = b.y + (b.h / 2) - 5;
+        labels.push_back(StrokeLabel{ b.label, tx, ty, charSize, 8.0f });
+    }
 
-                int personFloor = (int)(personY / getFloorH());
-                std::cout << "Pozivam lift na sprat: " << personFloor << std::endl;
+    // --- C) IME I PREZIME ---
+    std::string_view ime = "IVANA RADOVANOVIC";
+    std::string_view indeks = "SV 23/2022";
 
-                // Ako je lift vec tu i otvoren, koristi W za ulaz
-                if (!(liftState == DOOR_OPEN && currentFloor == personFloor)) {
-                    floorRequests[personFloor] = true;
-                    checkRequests();
-                }
-            }
-        }
+    float nameScale = 12.0f;
+    float letterSpacing = 18.0f;
 
-        // 2. OSOBA JE U LIFTU
-        else {
-            if (key == GLFW_KEY_A) {
-                // === LOGIKA IZLASKA IZ LIFTA (A) ===
-                // Izlazak moguc samo ako su vrata otvorena
-                if (liftState == DOOR_OPEN) {
-                    personInLift = false; // <--- OSOBA IZLAZI
-
-                    // Izbaci osobu ispred lifta
-                    personX = getLiftVisualX() - 30.0f;
-
-                    // Postavi je na visinu trenutnog sprata
-                    personY = currentFloor * getFloorH();
-                    std::cout << "Izasao iz lifta na spratu: " << currentFloor << std::endl;
-                }
-            }
-            // W i C ne rade nista dok si u liftu (vozis se)
-        }
-    }
+    // 1. IME
+    float nameX = (f.panelWidth / 2.0f) - ((ime.length() * letterSpacing) / 2.0f);
+    float nameY = f.height * 0.15f; // Visina od dna
+    labels.push_back(StrokeLabel{ ime, nameX, nameY, nameScale, letterSpacing });
+
+    // 2. INDEKS
+    float indX = (f.panelWidth / 2.0f) - ((indeks.length() * letterSpacing) / 2.0f);
+    float indY = nameY - 40.0f;
+    labels.push_back(StrokeLabel{ indeks, indX, indY, nameScale, letterSpacing });
+}
+
+// Gradi bafere ponovo samo ako se raspored promenio
+void updateTextCache(TextCache& text, const FrameState& f, const StrokeAtlas& atlas) {
+    if (text.built && text.layoutVersion == f.layoutVersion) return;
+    buildTextLabels(f, text.floorNames, text.labels);
+
+    // Jedna alokacija po nizu, pa svi natpisi odjednom
+    text.lines.resize(strokeFloatCount(text.labels));
+    emitStrokeLabels(text.lines, text.labels);
+    glBindBuffer(GL_ARRAY_BUFFER, text.lineBuffer);
+    glBufferData(GL_ARRAY_BUFFER, text.lines.size() * sizeof(float), text.lines.data(), GL_STATIC_DRAW);
+    text.lineVertexCount = (GLsizei)(text.lines.size() / 2);
+
+    text.quads.resize(strokeQuadCount(text.labels));
+    emitGlyphQuads(text.quads, text.labels, atlas);
+    glBindBuffer(GL_ARRAY_BUFFER, text.quadBuffer);
+    glBufferData(GL_ARRAY_BUFFER, text.quads.size() * sizeof(GlyphQuad), text.quads.data(), GL_STATIC_DRAW);
+    text.quadCount = (GLsizei)text.quads.size();
+
+    text.layoutVersion = f.layoutVersion;
+    text.built = true;
 }
 
 // --- INPUTS ---
-void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
-    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
-        double x, y;
-        glfwGetCursorPos(window, &x, &y);
-        float clickX = (float)x;
-        float clickY = WINDOW_HEIGHT - (float)y;
-
-        if (personInLift) {
-            for (auto& b : buttons) {
-                if (clickX >= b.x && clickX <= b.x + b.w && clickY >= b.y && clickY <= b.y + b.h) {
-
-                    if (b.actionType == 0) { // SPRAT
-                        b.isPressed = true;
-                        floorRequests[b.floorIndex] = true;
-                        checkRequests();
-                    }
-                    else if (b.actionType == 1) { // OTVORI
-                        if (liftState == DOOR_OPEN && !extendedOnce) {
-                            doorOpenTimeStart = glfwGetTime();
-                            extendedOnce = true;
-                            std::cout << "Vrata produzena!" << std::endl;
-                        }
-                    }
-                    else if (b.actionType == 2) { // ZATVORI
-                        if (liftState == DOOR_OPEN) liftState = DOOR_CLOSING;
-                    }
-                    else if (b.actionType == 3) { // STOP
-                        liftState = IDLE;
-                        for (int i = 0; i < 8; i++) floorRequests[i] = false;
-                        for (auto& bb : buttons) bb.isPressed = false;
-                        liftState = DOOR_OPENING;
-                    }
-                    else if (b.actionType == 4) { // VENTILACIJA
-                        // Samo menjamo bool vrednost, kursor sredjujemo u main-u
-                        ventilationOn = !ventilationOn;
-                    }
-                }
-            }
-        }
+// Prozor ne menja stanje: callback samo stavi ulaz u red niti simulacije
+// (par desetina nanosekundi), a nit ga primenjuje na granici koraka
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    if (key == GLFW_KEY_F5 && action == GLFW_PRESS) {
+        requestSnapshot(simThread);
+        return;
+    }
+    // F6: tekst iz atlasa ili linijama (samo prikaz, nit ga ne vidi)
+    if (key == GLFW_KEY_F6 && action == GLFW_PRESS) {
+        atlasText = !atlasText;
+        return;
     }
+    postInput(simThread, keyRecord(key, action, mods));
+}
+
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
+    if (button != GLFW_MOUSE_BUTTON_LEFT || action != GLFW_PRESS) return;
+    double x, y;
+    glfwGetCursorPos(window, &x, &y);
+    postInput(simThread, clickRecord(button, action, (float)x, (float)y));
 }
 
 int endProgram(std::string message) {
@@ -572,6 +489,8 @@ int main()
 
     unsigned int basicShader = createShader("basic.vert", "basic.frag");
     unsigned int textureShader = createShader("texture.vert", "texture.frag");
+    unsigned int rectShader = createShader("rect.vert", "rect.frag");
+    unsigned int textShader = createShader("text.vert", "text.frag");
 
     // --- UCITAVANJE SLIKA ---
     buildingTexture = loadTexture("building.png");
@@ -590,6 +509,11 @@ int main()
     // --- BAFERI ---
     float rectVertices[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f,
                              0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+    // Prsten za svu geometriju koja se menja svakog frejma; VAO-i ispod
+    // citaju iz njega, a pomeraj postavljaju pred svako crtanje
+    StreamBuffer stream;
+    initStreamBuffer(stream, STREAM_MIN_SECTION);
+
     unsigned int VAO_Rect, VBO_Rect;
     glGenVertexArrays(1, &VAO_Rect);
     glGenBuffers(1, &VBO_Rect);
@@ -599,6 +523,16 @@ int main()
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
+    // Pravougaonik i boja po instanci (pomeraj sloja postavlja drawRectLayer)
+    glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(RectInstance), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(RectInstance), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    RectBatch rects;
+
     float texVertices[] = {
         0.0f, 0.0f,  0.0f, 0.0f,
         1.0f, 0.0f,  1.0f, 0.0f,
@@ -619,48 +553,49 @@ int main()
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    unsigned int VAO_Line, VBO_Line;
+    unsigned int VAO_Line;
     glGenVertexArrays(1, &VAO_Line);
-    glGenBuffers(1, &VBO_Line);
     glBindVertexArray(VAO_Line);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_Line);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
-    unsigned int VAO_Fan, VBO_Fan;
+    unsigned int VAO_Fan;
     glGenVertexArrays(1, &VAO_Fan);
-    glGenBuffers(1, &VBO_Fan);
     glBindVertexArray(VAO_Fan);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_Fan);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
     int uResLoc = glGetUniformLocation(basicShader, "uRes");
-    int uRectLoc = glGetUniformLocation(basicShader, "uRect");
     int uColorLoc = glGetUniformLocation(basicShader, "uColor");
     int uIsLineLoc = glGetUniformLocation(basicShader, "uIsLine");
 
     int uTexResLoc = glGetUniformLocation(textureShader, "uRes");
     int uTexRectLoc = glGetUniformLocation(textureShader, "uRect");
 
-    int width, height;
-    glfwGetFramebufferSize(window, &width, &height);
-    WINDOW_WIDTH = (float)width;
-    WINDOW_HEIGHT = (float)height;
-    glViewport(0, 0, width, height);
+    int uRectResLoc = glGetUniformLocation(rectShader, "uRes");
+
+    int uTextResLoc = glGetUniformLocation(textShader, "uRes");
+    int uTextColorLoc = glGetUniformLocation(textShader, "uColor");
+    glUseProgram(textShader);
+    glUniform1i(glGetUniformLocation(textShader, "uAtlas"), 0);
+    std::vector<float> outlines;    // Okviri dugmadi: prvo obicni, pa pritisnuti
+    StrokeAtlas atlas;
+    buildStrokeAtlas(atlas);
+    unsigned int atlasTexture = createAtlasTexture(atlas);
+    TextCache text;
+    initTextCache(text, VBO_Rect);
 
-    glUseProgram(basicShader);
-    glUniform2f(uResLoc, WINDOW_WIDTH, WINDOW_HEIGHT);
+    int width, height;
     glUseProgram(textureShader);
-    glUniform2f(uTexResLoc, WINDOW_WIDTH, WINDOW_HEIGHT);
     glUniform1i(glGetUniformLocation(textureShader, "texture1"), 0);
 
-    initLogic();
-
-    bool firstLoop = true;
+    startSimThread(simThread, (uint64_t)glfwGetTimerValue(), GUI_INPUT_LOG, GUI_SNAPSHOT, GUI_TICKS_PER_WAKE);
+    FrameMotion view; // Kabine, vrata i osoba u trenutku crtanja
+    float sentWidth = 0.0f, sentHeight = 0.0f; // Poslednja velicina poslata niti
 
     // SAKRIVAMO SISTEMSKI KURSOR
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
@@ -670,136 +605,165 @@ int main()
         glfwGetFramebufferSize(window, &width, &height);
         if (width == 0 || height == 0) { glfwPollEvents(); continue; }
 
-        if (firstLoop || (float)width != WINDOW_WIDTH || (float)height != WINDOW_HEIGHT) {
-            float scaleX = (float)width / WINDOW_WIDTH;
-            float scaleY = (float)height / WINDOW_HEIGHT;
-            WINDOW_WIDTH = (float)width;
-            WINDOW_HEIGHT = (float)height;
+        // Promena velicine je ulaz kao i svaki drugi (prva postavlja osobu i dugmad)
+        if ((float)width != sentWidth || (float)height != sentHeight) {
+            postInput(simThread, resizeRecord((float)width, (float)height));
+            sentWidth = (float)width;
+            sentHeight = (float)height;
             glViewport(0, 0, width, height);
-
-            glUseProgram(basicShader);
-            glUniform2f(uResLoc, WINDOW_WIDTH, WINDOW_HEIGHT);
-            glUseProgram(textureShader);
-            glUniform2f(uTexResLoc, WINDOW_WIDTH, WINDOW_HEIGHT);
-
-            if (!firstLoop) {
-                liftY *= scaleY;
-                personY *= scaleY;
-                float oldPersonX = personX;
-                personX *= scaleX;
-            }
-
-            PANEL_WIDTH = WINDOW_WIDTH * 0.35f;
-            if (personX < PANEL_WIDTH) personX = PANEL_WIDTH + 10;
-            initLogic();
-            firstLoop = false;
         }
 
-        updateApp();
         glfwPollEvents();
 
-        // svetlo plavu za nebo
-        glClearColor(0.7f, 0.9f, 1.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        // Poslednje stanje koje je nit objavila; dok ne stigne prvi raspored, nema sta da se crta
+        const FrameState& f = simThread.frames.read();
+        if (f.width <= 0.0f) continue;
+        interpolateFrame(f, std::chrono::steady_clock::now(), view);
 
-        // asfalt
         glUseProgram(basicShader);
-        glBindVertexArray(VAO_Rect);
-        glUniform1i(uIsLineLoc, 0);
-
-        // Boja asfalta (tamno siva)
-        glUniform4f(uColorLoc, 0.25f, 0.25f, 0.28f, 1.0f);
-
-        // Visina asfalta je 5% visine prozora
-        float asphaltHeight = WINDOW_HEIGHT * 0.05f;
-
-        glUniform4f(uRectLoc, 0.0f, 0.0f, WINDOW_WIDTH, asphaltHeight);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-
+        glUniform2f(uResLoc, f.width, f.height);
+        glUseProgram(textureShader);
+        glUniform2f(uTexResLoc, f.width, f.height);
+        glUseProgram(rectShader);
+        glUniform2f(uRectResLoc, f.width, f.height);
+        glUseProgram(textShader);
+        glUniform2f(uTextResLoc, f.width, f.height);
+
+        // --- RASPORED FREJMA ---
+        // Prvo se izracuna gde je sta i skupe svi pravougaonici po slojevima,
+        // pa se crta redom: sloj pravougaonika, tekstura, sloj, ...
+        float buildingWidth = f.width * 0.3f;
+        float buildingX = f.width - buildingWidth;
+        float fh = f.height / (float)f.floorCount;
+
+        int carCount = (int)view.cars.size();
+        float liftX, liftW;
+        float liftH = fh * 0.9f;
 
-        // 1. PANEL 
-        glUseProgram(basicShader);
-        glBindVertexArray(VAO_Rect);
-        glUniform1i(uIsLineLoc, 0);
-        glUniform4f(uColorLoc, 0.2f, 0.22f, 0.25f, 1.0f);
-        glUniform4f(uRectLoc, 0, 0, PANEL_WIDTH, WINDOW_HEIGHT);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        clearRects(rects);
+        outlines.clear();
+
+        // Asfalt (tamno siv, 5% visine prozora) i panel
+        float asphaltHeight = f.height * 0.05f;
+        addRect(rects, LAYER_BACKGROUND, 0.0f, 0.0f, f.width, asphaltHeight, 0.25f, 0.25f, 0.28f, 1.0f);
+        addRect(rects, LAYER_BACKGROUND, 0, 0, f.panelWidth, f.height, 0.2f, 0.22f, 0.25f, 1.0f);
+
+        // Dugmad: pozadina, okvir (linije) i unutrasnjost preko okvira
+        for (const Button& b : f.buttons) {
+            bool ventOn = b.actionType == 4 && f.ventilationOn;
+            float r = ventOn ? 0.0f : 0.4f, g = ventOn ? 0.8f : 0.4f, bl = ventOn ? 0.8f : 0.45f;
+            addRect(rects, LAYER_BACKGROUND, b.x, b.y, b.w, b.h, r, g, bl, 1.0f);
+            addRect(rects, LAYER_BUTTON_FILL, b.x + 2, b.y + 2, b.w - 4, b.h - 4, r, g, bl, 1.0f);
+            if (!(b.isPressed && b.actionType == 0)) appendOutline(outlines, b);
+        }
+        size_t thinOutlines = outlines.size() / 2;
+        for (const Button& b : f.buttons) {
+            if (b.isPressed && b.actionType == 0) appendOutline(outlines, b);
+        }
 
+        // Okna (providno tamna, jedno po kabini)
+        for (int i = 0; i < carCount; i++) {
+            getLiftDimensions(f, i, liftX, liftW);
+            addRect(rects, LAYER_SHAFTS, liftX, 0, liftW, f.height, 0.1f, 0.1f, 0.12f, 0.35f);
+        }
 
-        // 2. DUGMAD
-        for (auto& b : buttons) {
-            if (b.actionType == 0) {
-                b.isPressed = floorRequests[b.floorIndex];
+        // Putnici iz simulacije: red ispred okana na svakom spratu i putnici u
+        // kabinama (koliko ih stane; ostali se ne crtaju)
+        float paxW = fmaxf(2.0f, fh * 0.05f);
+        float paxH = fh * 0.3f;
+        float paxStep = paxW * 1.6f;
+
+        getLiftDimensions(f, carCount - 1, liftX, liftW);
+        int queueFits = (int)((liftX - f.panelWidth - 10.0f) / paxStep);
+        for (int i = 0; i < f.floorCount; i++) {
+            int n = (f.waiting[i] < queueFits) ? f.waiting[i] : queueFits;
+            for (int k = 0; k < n; k++) {
+                addRect(rects, LAYER_PASSENGERS, liftX - (k + 1) * paxStep, i * fh + fh * 0.05f, paxW, paxH,
+                        0.85f, 0.45f, 0.1f, 1.0f);
+            }
+        }
+        for (int i = 0; i < carCount; i++) {
+            getLiftDimensions(f, i, liftX, liftW);
+            int perRow = (int)(liftW * 0.8f / paxStep);
+            int rows = (int)(liftH * 0.8f / (paxH * 1.1f));
+            int n = (f.riders[i] < perRow * rows) ? f.riders[i] : perRow * rows;
+            for (int k = 0; k < n; k++) {
+                float px = liftX + liftW * 0.1f + (k % perRow) * paxStep;
+                float py = view.cars[i].position * fh + liftH * 0.1f + (k / perRow) * paxH * 1.1f;
+                addRect(rects, LAYER_PASSENGERS, px, py, paxW, paxH, 0.85f, 0.45f, 0.1f, 1.0f);
             }
+        }
 
-            // POZADINA
-            glUseProgram(basicShader);
-            glBindVertexArray(VAO_Rect);
-            glUniform1i(uIsLineLoc, 0);
-            if (b.actionType == 4 && ventilationOn) glUniform4f(uColorLoc, 0.0f, 0.8f, 0.8f, 1.0f);
-            else glUniform4f(uColorLoc, 0.4f, 0.4f, 0.45f, 1.0f);
-            glUniform4f(uRectLoc, b.x, b.y, b.w, b.h);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
+        // Vrata (plava)
+        for (int i = 0; i < carCount; i++) {
+            getLiftDimensions(f, i, liftX, liftW);
+            float doorRectW = liftW * 0.4f;
+            float doorRectH = fh * 0.7f;
+            float doorRectX = liftX + (liftW - doorRectW) / 2.0f;
+            float currentDoorY = view.cars[i].position * fh + view.cars[i].door * f.maxDoorHeight;
+            addRect(rects, LAYER_DOORS, doorRectX, currentDoorY, doorRectW, doorRectH, 0.4f, 0.8f, 1.0f, 1.0f);
+        }
 
-            // OKVIR
-            std::vector<float> outline;
-            outline.push_back(b.x); outline.push_back(b.y);
-            outline.push_back(b.x + b.w); outline.push_back(b.y);
-            outline.push_back(b.x + b.w); outline.push_back(b.y);
-            outline.push_back(b.x + b.w); outline.push_back(b.y + b.h);
-            outline.push_back(b.x + b.w); outline.push_back(b.y + b.h);
-            outline.push_back(b.x); outline.push_back(b.y + b.h);
-            outline.push_back(b.x); outline.push_back(b.y + b.h);
-            outline.push_back(b.x); outline.push_back(b.y);
-
-            glBindVertexArray(VAO_Line);
-            glBindBuffer(GL_ARRAY_BUFFER, VBO_Line);
-            glBufferData(GL_ARRAY_BUFFER, outline.size() * sizeof(float), outline.data(), GL_DYNAMIC_DRAW);
-            glUniform1i(uIsLineLoc, 1);
+        // Sve sto se menja ovog frejma ide u prsten (tekst ima svoj bafer)
+        packRects(rects);
+        size_t rectBytes = rects.all.size() * sizeof(RectInstance);
+        size_t outlineBytes = outlines.size() * sizeof(float);
+        const size_t fanBytes = 6 * 4 * sizeof(float);
+        beginStreamFrame(stream, streamBytes(rectBytes) + streamBytes(outlineBytes) + streamBytes(fanBytes));
+        StreamSpan rectSpan = streamWrite(stream, rects.all.data(), rectBytes);
+        StreamSpan outlineSpan = streamWrite(stream, outlines.data(), outlineBytes);
 
-            if (b.isPressed && b.actionType == 0) {
-                glUniform4f(uColorLoc, 1.0f, 1.0f, 1.0f, 1.0f);
-                glLineWidth(2.0f);
-            }
-            else {
-                glUniform4f(uColorLoc, 0.0f, 0.0f, 0.0f, 1.0f);
-                glLineWidth(1.0f);
-            }
-            glDrawArrays(GL_LINES, 0, (GLsizei)outline.size() / 2);
+        // svetlo plavu za nebo
+        glClearColor(0.7f, 0.9f, 1.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
 
-            // UNUTRASNJOST
-            glUseProgram(basicShader);
-            glBindVertexArray(VAO_Rect);
-            glUniform1i(uIsLineLoc, 0);
-            if (b.actionType == 4 && ventilationOn) glUniform4f(uColorLoc, 0.0f, 0.8f, 0.8f, 1.0f);
-            else glUniform4f(uColorLoc, 0.4f, 0.4f, 0.45f, 1.0f);
-            glUniform4f(uRectLoc, b.x + 2, b.y + 2, b.w - 4, b.h - 4);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-        }
+        // 1. ASFALT, PANEL I DUGMAD
+        glUseProgram(rectShader);
+        glBindVertexArray(VAO_Rect);
+        drawRectLayer(rects, LAYER_BACKGROUND, rectSpan);
+
+        // OKVIRI: obicni (crni, tanki) pa pritisnuti (beli, debli)
+        glUseProgram(basicShader);
+        glBindVertexArray(VAO_Line);
+        glUniform1i(uIsLineLoc, 1);
+        glUniform4f(uColorLoc, 0.0f, 0.0f, 0.0f, 1.0f);
+        glLineWidth(1.0f);
+        drawStreamLines(outlineSpan, 0, thinOutlines);
+        glUniform4f(uColorLoc, 1.0f, 1.0f, 1.0f, 1.0f);
+        glLineWidth(2.0f);
+        drawStreamLines(outlineSpan, thinOutlines, outlines.size() / 2 - thinOutlines);
+
+        glUseProgram(rectShader);
+        glBindVertexArray(VAO_Rect);
+        drawRectLayer(rects, LAYER_BUTTON_FILL, rectSpan);
 
         // 3. ZGRADA
         glUseProgram(textureShader);
         glBindVertexArray(VAO_Tex);
 
-        float buildingWidth = WINDOW_WIDTH * 0.3f;
-        float buildingX = WINDOW_WIDTH - buildingWidth;
-        float fh = getFloorH();
-
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, buildingTexture);
-        glUniform4f(uTexRectLoc, buildingX, 0, buildingWidth, WINDOW_HEIGHT);
+        glUniform4f(uTexRectLoc, buildingX, 0, buildingWidth, f.height);
         glDrawArrays(GL_TRIANGLES, 0, 6);
 
-        // 4. LIFT KABINA
+        // 4. OKNA I KABINE (jedno okno po kabini), pa putnici
+        glUseProgram(rectShader);
+        glBindVertexArray(VAO_Rect);
+        drawRectLayer(rects, LAYER_SHAFTS, rectSpan);
+
+        glUseProgram(textureShader);
+        glBindVertexArray(VAO_Tex);
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, liftTexture);
+        for (int i = 0; i < carCount; i++) {
+            getLiftDimensions(f, i, liftX, liftW);
+            glUniform4f(uTexRectLoc, liftX, view.cars[i].position * fh, liftW, liftH);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        }
 
-        float liftX, liftW;
-        getLiftDimensions(liftX, liftW);
-        float liftH = fh * 0.9f;
-
-        glUniform4f(uTexRectLoc, liftX, liftY, liftW, liftH);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        glUseProgram(rectShader);
+        glBindVertexArray(VAO_Rect);
+        drawRectLayer(rects, LAYER_PASSENGERS, rectSpan);
 
         // 5. OSOBA
         glUseProgram(textureShader);
@@ -814,13 +778,14 @@ int main()
         }
 
         float pDrawX, pDrawY;
-        if (personInLift) {
+        if (f.personInLift) {
+            getLiftDimensions(f, f.personCar, liftX, liftW);
             pDrawX = liftX + liftW / 2 - personW / 2;
-            pDrawY = liftY + 5;
+            pDrawY = view.cars[f.personCar].position * fh + 5;
         }
         else {
-            pDrawX = personX;
-            pDrawY = personY;
+            pDrawX = view.personX;
+            pDrawY = view.personY;
         }
 
         glActiveTexture(GL_TEXTURE0);
@@ -829,74 +794,28 @@ int main()
         glDrawArrays(GL_TRIANGLES, 0, 6);
 
         // 6. VRATA
-        glUseProgram(basicShader);
+        glUseProgram(rectShader);
         glBindVertexArray(VAO_Rect);
-        glUniform1i(uIsLineLoc, 0);
-
-        glUniform4f(uColorLoc, 0.4f, 0.8f, 1.0f, 1.0f); // Plava boja
-
-        float doorRectW = liftW * 0.4f;
-        float doorRectH = fh * 0.7f;
-        float doorRectX = liftX + (liftW - doorRectW) / 2.0f;
-        float currentDoorY = liftY + doorHeight;
-
-        glUniform4f(uRectLoc, doorRectX, currentDoorY, doorRectW, doorRectH);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-
-        // 7. LINIJE I TEKST
-        std::vector<float> lines;
-
-        // A) Linije za spratove
-        for (int i = 0; i < 8; i++) {
-            float y = i * fh;
-            float tx = buildingX - 30;
-            float ty = y + fh / 2 - 5;
-            for (char c : floorNames[i]) { appendChar(lines, c, tx, ty, fh * 0.08f); tx += fh * 0.13f; }
-        }
-
-        // B) Tekst na dugmadima
-        for (auto& b : buttons) {
-            float charSize = b.h * 0.15f;
-            float textLen = b.label.length() * (charSize + 6.0f);
-            float tx = b.x + (b.w - textLen) / 2 + 5;
-            float ty = b.y + (b.h / 2) - 5;
-            for (char c : b.label) { appendChar(lines, c, tx, ty, charSize); tx += 8.0f; }
-        }
-        // --- C) IME I PREZIME ---
-        std::string ime = "IVANA RADOVANOVIC";   
-        std::string indeks = "SV 23/2022"; 
-
-        float nameScale = 12.0f;     
-        float letterSpacing = 18.0f; 
-
-        // 1. CRTANJE IMENA
-        float nameX = (PANEL_WIDTH / 2.0f) - ((ime.length() * letterSpacing) / 2.0f);
-        float nameY = WINDOW_HEIGHT * 0.15f; // Visina od dna
-
-        for (char c : ime) {
-            appendChar(lines, c, nameX, nameY, nameScale);
-            nameX += letterSpacing; // Pomeramo se za sledece slovo
+        drawRectLayer(rects, LAYER_DOORS, rectSpan);
+
+        // 7. TEKST (iz kesa, gradi se samo kad se raspored promeni)
+        updateTextCache(text, f, atlas);
+        if (atlasText) {
+            glUseProgram(textShader);
+            glBindVertexArray(text.quadVao);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, atlasTexture);
+            glUniform4f(uTextColorLoc, 0.0f, 0.0f, 0.0f, 1.0f); // Crna boja teksta
+            glDrawArraysInstanced(GL_TRIANGLES, 0, 6, text.quadCount);
         }
-
-        // 2. CRTANJE INDEKSA
-        float indX = (PANEL_WIDTH / 2.0f) - ((indeks.length() * letterSpacing) / 2.0f);
-        float indY = nameY - 40.0f;
-
-        for (char c : indeks) {
-            appendChar(lines, c, indX, indY, nameScale);
-            indX += letterSpacing;
+        else {
+            glUseProgram(basicShader);
+            glBindVertexArray(text.lineVao);
+            glUniform1i(uIsLineLoc, 1);
+            glUniform4f(uColorLoc, 0.0f, 0.0f, 0.0f, 1.0f);
+            glLineWidth(1.0f);
+            glDrawArrays(GL_LINES, 0, text.lineVertexCount);
         }
-   
-        // --------------------------------------------------------
-
-        // D) KONACNO CRTANJE SVIH LINIJA
-        glBindVertexArray(VAO_Line);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO_Line);
-        glBufferData(GL_ARRAY_BUFFER, lines.size() * sizeof(float), lines.data(), GL_DYNAMIC_DRAW);
-
-        glUniform1i(uIsLineLoc, 1);
-        glUniform4f(uColorLoc, 0.0f, 0.0f, 0.0f, 1.0f); // Crna boja teksta
-        glDrawArrays(GL_LINES, 0, (GLsizei)lines.size() / 2);
 
         // 8. VENTILATOR KAO KURSOR (UVEK VIDLJIV)
 
@@ -909,16 +828,16 @@ int main()
 
         double cx, cy; glfwGetCursorPos(window, &cx, &cy);
         float mx = (float)cx;
-        float my = WINDOW_HEIGHT - (float)cy;
+        float my = f.height - (float)cy;
 
         // --- LOGIKA STANJA ---
         unsigned int textureToUse;
         float angle;
 
         // Ako je ventilacija UPALJENA
-        if (ventilationOn) {
+        if (f.ventilationOn) {
             textureToUse = fanColorTexture;       // Koristi sliku U BOJI
-            angle = (float)glfwGetTime() * 15.0f; // ROTIRAJ SE
+            angle = (float)fmod(view.time * 15.0, 2.0 * 3.14159265358979); // ROTIRAJ SE (po simulacionom satu)
         }
         // Ako je ventilacija UGASENA
         else {
@@ -952,9 +871,11 @@ int main()
             mx + r4x, my + r4y,  0.0f, 1.0f
         };
 
-        // Slanje podataka
-        glBindBuffer(GL_ARRAY_BUFFER, VBO_Fan);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(finalVertices), finalVertices, GL_DYNAMIC_DRAW);
+        // Slanje podataka (u prsten, mesto je rezervisano na pocetku frejma)
+        StreamSpan fanSpan = streamWrite(stream, finalVertices, fanBytes);
+        glBindBuffer(GL_ARRAY_BUFFER, fanSpan.buffer);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)fanSpan.offset);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(fanSpan.offset + 2 * sizeof(float)));
 
         // Aktiviranje odabrane teksture (Crne ili Obojene)
         glActiveTexture(GL_TEXTURE0);
@@ -963,8 +884,11 @@ int main()
         glUniform4f(uTexRectLoc, 0.0f, 0.0f, 1.0f, 1.0f);
         glDrawArrays(GL_TRIANGLES, 0, 6);
 
+        endStreamFrame(stream);
         glfwSwapBuffers(window);
     }
+    stopSimThread(simThread);
+    if (simThread.droppedInputs > 0) std::cout << "Odbaceno ulaza (pun red): " << simThread.droppedInputs << std::endl;
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+#include <vector>
+#include <bit>
+#include <cstdint>
+
+// --- SKUP POZIVA PO SPRATOVIMA ---
+// Bitset spakovan u 64-bitne reci, plus jedna "summary" rec u kojoj bit w
+// kaze da li rec w ima ijedan poziv. "Sledeci poziv iznad/ispod" je zato
+// najvise dve maskirane countr_zero/countl_zero operacije, bez petlje po
+// spratovima, za do 64 * 64 = 4096 spratova.
+class RequestSet {
+public:
+    static const int MAX_FLOORS = 64 * 64;
+
+    void resize(int floorCount) {
+        floors = floorCount;
+        words.assign((floorCount + 63) / 64, 0);
+        summary = 0;
+    }
+
+    int size() const { return floors; }
+
+    // Sirove reci (za otisak stanja i snimke)
+    const uint64_t* data() const { return words.data(); }
+    int wordCount() const { return (int)words.size(); }
+
+    // Upisuje wordCount() reci (velicina mora vec da bude postavljena)
+    void assign(const uint64_t* data) {
+        summary = 0;
+        for (int w = 0; w < (int)words.size(); w++) {
+            words[w] = data[w];
+            if (words[w]) summary |= 1ull << w;
+        }
+    }
+    bool any() const { return summary != 0; }
+
+    int count() const {
+        int n = 0;
+        for (uint64_t w : words) n += std::popcount(w);
+        return n;
+    }
+
+    bool test(int f) const { return (words[f >> 6] >> (f & 63)) & 1; }
+
+    void set(int f) {
+        words[f >> 6] |= 1ull << (f & 63);
+        summary |= 1ull << (f >> 6);
+    }
+
+    void reset(int f) {
+        uint64_t& w = words[f >> 6];
+        w &= ~(1ull << (f & 63));
+        if (w == 0) summary &= ~(1ull << (f >> 6));
+    }
+
+    void clear() {
+        for (uint64_t& w : words) w = 0;
+        summary = 0;
+    }
+
+    // Najnizi sprat sa pozivom strogo iznad f, ili -1
+    int nextAbove(int f) const {
+        int i = f + 1;
+        if (i >= floors) return -1;
+        int w = i >> 6;
+        uint64_t bits = words[w] & (~0ull << (i & 63));
+        if (bits) return (w << 6) + std::countr_zero(bits);
+
+        uint64_t rest = (w + 1 < 64) ? (summary & (~0ull << (w + 1))) : 0;
+        if (!rest) return -1;
+        int w2 = std::countr_zero(rest);
+        return (w2 << 6) + std::countr_zero(words[w2]);
+    }
+
+    // Najvisi sprat sa pozivom strogo ispod f, ili -1
+    int nextBelow(int f) const {
+        int i = f - 1;
+        if (i < 0) return -1;
+        int w = i >> 6;
+        uint64_t bits = words[w] & (~0ull >> (63 - (i & 63)));
+        if (bits) return (w << 6) + 63 - std::countl_zero(bits);
+
+        uint64_t rest = summary & ((1ull << w) - 1);
+        if (!rest) return -1;
+        int w2 = 63 - std::countl_zero(rest);
+        return (w2 << 6) + 63 - std::countl_zero(words[w2]);
+    }
+
+private:
+    std::vector<uint64_t> words;
+    uint64_t summary = 0;
+    int floors = 0;
+};
@@ -0,0 +1,225 @@
+#include "Script.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <new>
+
+// --- BAZEN OKVIRA ---
+// Za svaku klasu velicine lista slobodnih blokova; slobodan blok u svojim
+// prvim bajtovima cuva pokazivac na sledeci
+struct FramePool {
+    void* freeList[SCRIPT_FRAME_CLASSES] = {};
+    std::vector<std::unique_ptr<char[]>> chunks;
+    ScriptPoolStats stats;
+};
+
+static thread_local FramePool framePool;
+
+// Klasa velicine za okvir od size bajtova, ili -1 ako je prevelik za bazen
+static int frameClass(size_t size) {
+    size_t block = SCRIPT_FRAME_MIN;
+    for (int c = 0; c < SCRIPT_FRAME_CLASSES; c++, block *= 2) {
+        if (size <= block) return c;
+    }
+    return -1;
+}
+
+void* allocateScriptFrame(size_t size) {
+    FramePool& pool = framePool;
+    if (++pool.stats.live > pool.stats.peak) pool.stats.peak = pool.stats.live;
+
+    int c = frameClass(size);
+    if (c < 0) {
+        pool.stats.heap++;
+        return ::operator new(size);
+    }
+
+    if (!pool.freeList[c]) {
+        // Nov blok: SCRIPT_POOL_CHUNK okvira ove klase, ulancanih u listu slobodnih
+        size_t block = SCRIPT_FRAME_MIN << c;
+        pool.chunks.emplace_back(new char[block * SCRIPT_POOL_CHUNK]);
+        pool.stats.chunks++;
+        char* base = pool.chunks.back().get();
+        for (size_t i = 0; i < SCRIPT_POOL_CHUNK; i++) {
+            void* frame = base + i * block;
+            *(void**)frame = pool.freeList[c];
+            pool.freeList[c] = frame;
+        }
+    }
+    void* frame = pool.freeList[c];
+    pool.freeList[c] = *(void**)frame;
+    pool.stats.pooled++;
+    return frame;
+}
+
+void freeScriptFrame(void* frame, size_t size) {
+    FramePool& pool = framePool;
+    assert(pool.stats.live > 0 && "okvir skripte oslobodjen na niti koja ga nije alocirala");
+    pool.stats.live--;
+
+    int c = frameClass(size);
+    if (c < 0) {
+        ::operator delete(frame);
+        return;
+    }
+    *(void**)frame = pool.freeList[c];
+    pool.freeList[c] = frame;
+}
+
+ScriptPoolStats scriptPoolStats() {
+    return framePool.stats;
+}
+
+// --- RASPORED ---
+
+static bool timerLater(const ScriptTimer& a, const ScriptTimer& b) {
+    if (a.time != b.time) return a.time > b.time;
+    return a.sequence > b.sequence;
+}
+
+// Korutine (i njihovi okviri) smeju da se diraju samo na niti na kojoj su nastale
+static void assertOwnerThread(const ScriptScheduler& s) {
+    assert((pendingScripts(s) == 0 || s.owner == std::this_thread::get_id()) && "skripte se koriste sa druge niti");
+    (void)s;
+}
+
+static void destroyPending(ScriptScheduler& s) {
+    assertOwnerThread(s);
+    for (ScriptSlot& slot : s.slots) {
+        if (!slot.pending) continue;
+        slot.pending = false;
+        slot.handle.destroy();
+    }
+}
+
+ScriptScheduler::ScriptScheduler(ScriptScheduler&& other) noexcept {
+    *this = std::move(other);
+}
+
+ScriptScheduler& ScriptScheduler::operator=(ScriptScheduler&& other) noexcept {
+    if (this == &other) return *this;
+    destroyPending(*this);
+    now = other.now;
+    slots = std::move(other.slots);
+    freeSlots = std::move(other.freeSlots);
+    timers = std::move(other.timers);
+    timerSequence = other.timerSequence;
+    doors = std::move(other.doors);
+    waking = std::move(other.waking);
+    resumed = other.resumed;
+    owner = other.owner;
+    other.slots.clear();    // Korutine sada pripadaju ovom rasporedu
+    return *this;
+}
+
+ScriptScheduler::~ScriptScheduler() {
+    destroyPending(*this);
+}
+
+void initScripts(ScriptScheduler& s, int floorCount) {
+    s = ScriptScheduler();
+    s.doors.resize(floorCount);
+}
+
+size_t pendingScripts(const ScriptScheduler& s) {
+    return s.slots.size() - s.freeSlots.size();
+}
+
+double nextScriptTime(const ScriptScheduler& s) {
+    if (s.timers.empty()) return std::numeric_limits<double>::infinity();
+    return s.timers.front().time;
+}
+
+ScriptRef suspendScript(ScriptScheduler& s, std::coroutine_handle<> handle, int* result) {
+    assertOwnerThread(s);
+    s.owner = std::this_thread::get_id();
+
+    uint32_t index;
+    if (!s.freeSlots.empty()) {
+        index = s.freeSlots.back();
+        s.freeSlots.pop_back();
+    }
+    else {
+        index = (uint32_t)s.slots.size();
+        s.slots.emplace_back();
+    }
+    ScriptSlot& slot = s.slots[index];
+    slot.handle = handle;
+    slot.result = result;
+    slot.pending = true;
+    return ScriptRef{ index, slot.generation };
+}
+
+void addScriptTimer(ScriptScheduler& s, double time, ScriptRef ref) {
+    ScriptTimer timer;
+    timer.time = time;
+    timer.sequence = s.timerSequence++;
+    timer.ref = ref;
+    s.timers.push_back(timer);
+    std::push_heap(s.timers.begin(), s.timers.end(), timerLater);
+}
+
+void addDoorWaiter(ScriptScheduler& s, int floor, int dir, int car, ScriptRef ref) {
+    if (floor < 0 || floor >= (int)s.doors.size()) return;
+    DoorWaiter w;
+    w.ref = ref;
+    w.dir = dir;
+    w.car = car;
+    s.doors[floor].push_back(w);
+}
+
+static bool isCurrent(const ScriptScheduler& s, ScriptRef ref) {
+    const ScriptSlot& slot = s.slots[ref.slot];
+    return slot.pending && slot.generation == ref.generation;
+}
+
+// Zavrsava cekanje sa datim rezultatom i nastavlja korutinu. Mesto se
+// oslobadja pre nastavka, jer korutina odmah moze da ceka ponovo.
+static void resume(ScriptScheduler& s, ScriptRef ref, int result) {
+    assertOwnerThread(s);
+    ScriptSlot& slot = s.slots[ref.slot];
+    std::coroutine_handle<> handle = slot.handle;
+    *slot.result = result;
+    slot.pending = false;
+    slot.generation++;
+    s.freeSlots.push_back(ref.slot);
+    s.resumed++;
+    handle.resume();
+}
+
+void runScriptTimers(ScriptScheduler& s, double t) {
+    s.now = t;
+    while (!s.timers.empty() && s.timers.front().time <= t) {
+        std::pop_heap(s.timers.begin(), s.timers.end(), timerLater);
+        ScriptTimer timer = s.timers.back();
+        s.timers.pop_back();
+        if (isCurrent(s, timer.ref)) resume(s, timer.ref, -1);
+    }
+}
+
+void notifyDoorOpen(ScriptScheduler& s, int floor, int dir, int car) {
+    if (floor < 0 || floor >= (int)s.doors.size() || s.doors[floor].empty()) return;
+
+    // Prvo se izdvoje svi koji se bude (i izbace zastareli), pa tek onda
+    // nastavljaju: nastavljena korutina moze da doda novo cekanje na ovaj sprat
+    std::vector<DoorWaiter>& list = s.doors[floor];
+    s.waking.clear();
+    size_t kept = 0;
+    for (size_t i = 0; i < list.size(); i++) {
+        const DoorWaiter& w = list[i];
+        if (!isCurrent(s, w.ref)) continue;
+        bool match = (w.dir == 0 || w.dir == dir) && (w.car < 0 || w.car == car);
+        if (match) s.waking.push_back(w);
+        else list[kept++] = w;
+    }
+    list.resize(kept);
+
+    // Korutina ne budi druge (to radi samo petlja dogadjaja), pa se waking
+    // ne menja dok traje nastavljanje
+    for (size_t i = 0; i < s.waking.size(); i++) {
+        ScriptRef ref = s.waking[i].ref;
+        if (isCurrent(s, ref)) resume(s, ref, car);
+    }
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// --- SKRIPTE PUTNIKA (KORUTINE) ---
+// Ponasanje putnika (hoda do lifta, pozove ga, ceka, udje, vozi se, izadje)
+// pise se kao obicna funkcija koja ceka dogadjaje simulacije:
+//
+//     ScriptTask putnik(Simulation& sim, ...) {
+//         co_await delay(sim.scripts, 8.0);                       // Hoda do lifta
+//         hallCall(sim, floor, CALL_UP);
+//         int car = co_await waitForDoor(sim.scripts, floor, CALL_UP, -1, 60.0);
+//         if (car < 0) co_return;                                 // Nije docekao
+//         ...
+//     }
+//
+// umesto automata stanja sa zastavicama (kao personInLift u App.cpp).
+//
+// Raspored (ScriptScheduler) zivi u Simulation i nastavlja korutine iz
+// petlje dogadjaja (advanceTo): tajmere po simulacionom satu, a cekanje na
+// vrata kad se vrata neke kabine otvore na tom spratu. Korutina se nastavlja
+// tacno jednom, sa onim sto se prvo desilo (vrata ili isteklo vreme).
+//
+// Okviri korutina idu iz bazena blokova fiksne velicine (po niti), pa ni
+// milion putnika koji cekaju ne znaci milion alokacija na heap-u: blokovi se
+// alociraju po SCRIPT_POOL_CHUNK odjednom i vracaju u listu slobodnih.
+// Zato se skripte jedne simulacije pokrecu, nastavljaju i unistavaju na istoj
+// niti: okvir oslobodjen na drugoj niti zavrsio bi u tudjem bazenu. Raspored
+// pamti nit svojih korutina i to proverava (assert) pri svakom nastavljanju i
+// unistavanju; Sweep vec pravi i gasi svaku simulaciju na jednoj niti.
+//
+// Korutine nisu deo snimka stanja (Snapshot.h) i drze referencu na svoju
+// simulaciju, pa se Simulation sa pokrenutim skriptama ne premesta.
+
+const size_t SCRIPT_FRAME_MIN = 64;         // Najmanja klasa okvira (bajtova)
+const int SCRIPT_FRAME_CLASSES = 5;         // 64, 128, 256, 512, 1024; vece idu na heap
+const size_t SCRIPT_POOL_CHUNK = 4096;      // Okvira po bloku bazena
+
+struct ScriptPoolStats {
+    long long pooled = 0;       // Okviri iz bazena
+    long long heap = 0;         // Okviri preveliki za bazen
+    long long live = 0;         // Trenutno zivih okvira
+    long long peak = 0;         // Najvise zivih odjednom
+    long long chunks = 0;       // Blokova bazena (svaki je jedna alokacija)
+};
+
+// Bazen okvira ove niti; okvir se oslobadja na niti koja ga je alocirala
+void* allocateScriptFrame(size_t size);
+void freeScriptFrame(void* frame, size_t size);
+ScriptPoolStats scriptPoolStats();
+
+// Povratni tip skripte: pokrece se odmah i niko je ne ceka; okvir se
+// oslobadja sam kad se skripta zavrsi
+struct ScriptTask {
+    struct promise_type {
+        ScriptTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        static void* operator new(size_t size) { return allocateScriptFrame(size); }
+        static void operator delete(void* frame, size_t size) { freeScriptFrame(frame, size); }
+    };
+};
+
+// Jedno cekanje (tajmer i/ili vrata). Ako cekanje ima oba, oba zapisa
+// pokazuju na isto mesto; prvi ga nastavlja, a drugi vidi drugu generaciju
+// i preskace se.
+struct ScriptSlot {
+    std::coroutine_handle<> handle;
+    int* result = nullptr;      // U okviru korutine (u awaiter-u)
+    uint32_t generation = 0;
+    bool pending = false;
+};
+
+struct ScriptRef {
+    uint32_t slot = 0;
+    uint32_t generation = 0;
+};
+
+struct ScriptTimer {
+    double time = 0.0;
+    uint64_t sequence = 0;      // Isti trenutak: redom zakazivanja
+    ScriptRef ref;
+};
+
+struct DoorWaiter {
+    ScriptRef ref;
+    int dir = 0;                // CALL_UP / CALL_DOWN, 0 = bilo koji smer
+    int car = -1;               // -1 = bilo koja kabina
+};
+
+struct ScriptScheduler {
+    double now = 0.0;           // Simulacioni sat poslednje obrade (advanceTo ga postavlja)
+
+    std::vector<ScriptSlot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::vector<ScriptTimer> timers;            // Heap, najraniji na vrhu
+    uint64_t timerSequence = 0;
+    std::vector<std::vector<DoorWaiter>> doors; // Po spratu
+    std::vector<DoorWaiter> waking;             // Radni prostor za notifyDoorOpen
+
+    long long resumed = 0;
+    std::thread::id owner;      // Nit na kojoj su korutine nastale (i ciji bazen drzi njihove okvire)
+
+    ScriptScheduler() = default;
+    ScriptScheduler(const ScriptScheduler&) = delete;
+    ScriptScheduler& operator=(const ScriptScheduler&) = delete;
+    ScriptScheduler(ScriptScheduler&& other) noexcept;
+    ScriptScheduler& operator=(ScriptScheduler&& other) noexcept;
+    ~ScriptScheduler();         // Unistava korutine koje jos cekaju
+};
+
+void initScripts(ScriptScheduler& s, int floorCount);
+
+// Broj korutina koje cekaju
+size_t pendingScripts(const ScriptScheduler& s);
+
+// Vreme najranijeg tajmera (beskonacno ako ga nema)
+double nextScriptTime(const ScriptScheduler& s);
+
+// Nastavlja korutine ciji je tajmer istekao do trenutka t (s.now = t)
+void runScriptTimers(ScriptScheduler& s, double t);
+
+// Vrata kabine car su se otvorila na spratu floor, najavljeni smer dir
+void notifyDoorOpen(ScriptScheduler& s, int floor, int dir, int car);
+
+// --- CEKANJA (co_await) ---
+ScriptRef suspendScript(ScriptScheduler& s, std::coroutine_handle<> handle, int* result);
+void addScriptTimer(ScriptScheduler& s, double time, ScriptRef ref);
+void addDoorWaiter(ScriptScheduler& s, int floor, int dir, int car, ScriptRef ref);
+
+// co_await sleepUntil(s, t): nastavlja u trenutku t (odmah ako je t proslo)
+struct ScriptSleep {
+    ScriptScheduler& s;
+    double time;
+    int result = 0;
+
+    bool await_ready() const { return time <= s.now; }
+    void await_suspend(std::coroutine_handle<> h) { addScriptTimer(s, time, suspendScript(s, h, &result)); }
+    void await_resume() const {}
+};
+
+inline ScriptSleep sleepUntil(ScriptScheduler& s, double time) { return ScriptSleep{ s, time }; }
+inline ScriptSleep delay(ScriptScheduler& s, double seconds) { return ScriptSleep{ s, s.now + seconds }; }
+
+// int car = co_await waitForDoor(s, floor, dir, car, timeout): kabina koja je
+// otvorila vrata na spratu floor (u smeru dir, ako je dir != 0; samo kabina
+// car, ako je car >= 0), ili -1 ako je proslo timeout sekundi
+struct ScriptDoorWait {
+    ScriptScheduler& s;
+    int floor;
+    int dir;
+    int car;
+    double timeout;
+    int result = -1;
+
+    bool await_ready() const { return false; }
+    void await_suspend(std::coroutine_handle<> h) {
+        ScriptRef ref = suspendScript(s, h, &result);
+        addDoorWaiter(s, floor, dir, car, ref);
+        if (timeout >= 0.0) addScriptTimer(s, s.now + timeout, ref);
+    }
+    int await_resume() const { return result; }
+};
+
+// timeout < 0: bez isteka
+inline ScriptDoorWait waitForDoor(ScriptScheduler& s, int floor, int dir, int car, double timeout) {
+    return ScriptDoorWait{ s, floor, dir, car, timeout };
+}
@@ -0,0 +1,161 @@
+#include "SimThread.h"
+#include "Snapshot.h"
+
+#include <chrono>
+#include <iostream>
+
+void captureFrame(const App& app, FrameState& frame, const FrameState& previous) {
+    const Simulation& sim = app.sim;
+    frame.tick = app.ticks;
+    frame.timeScale = stepsPerTick(app);
+    frame.width = app.width;
+    frame.height = app.height;
+    frame.panelWidth = app.panelWidth;
+    frame.maxDoorHeight = app.maxDoorHeight;
+    frame.floorCount = sim.floorCount;
+
+    FrameMotion& m = frame.motion;
+    m.time = sim.time;
+    m.cars.resize(sim.cars.size());
+    for (size_t i = 0; i < sim.cars.size(); i++) {
+        m.cars[i].position = (float)carPositionAt(sim.cars[i], sim.time);
+        m.cars[i].door = (float)carDoorAt(sim.cars[i], sim.time);
+    }
+    m.personX = app.personX;
+    m.personY = app.personY;
+
+    const Car& panel = sim.cars[app.personInLift ? app.personCar : 0];
+    frame.buttons = app.buttons;
+    frame.layoutVersion = app.layoutVersion;
+    for (Button& b : frame.buttons) {
+        if (b.actionType == 0) b.isPressed = panel.carCalls.test(b.floorIndex);
+    }
+    frame.ventilationOn = panel.ventilationOn;
+    frame.personInLift = app.personInLift;
+    frame.personCar = app.personCar;
+
+    frame.waiting.resize(sim.floorCount);
+    for (int f = 0; f < sim.floorCount; f++) frame.waiting[f] = (int)(sim.waitingUp[f].size() + sim.waitingDown[f].size());
+    frame.riders.resize(sim.riders.size());
+    for (size_t i = 0; i < sim.riders.size(); i++) frame.riders[i] = (int)sim.riders[i].size();
+
+    // Prva objava nema prethodnu: obe su iste
+    bool first = previous.motion.cars.size() != m.cars.size();
+    frame.previous = first ? m : previous.motion;
+    frame.smoothPerson = !first && previous.personInLift == app.personInLift
+                         && previous.width == app.width && previous.height == app.height;
+}
+
+static float lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+void interpolateFrame(const FrameState& frame, std::chrono::steady_clock::time_point now, FrameMotion& out) {
+    double elapsed = std::chrono::duration<double>(now - frame.stepTime).count();
+    double t = (frame.stepPeriod > 0.0) ? elapsed / frame.stepPeriod : 1.0;
+    if (t < 0.0) t = 0.0;
+    if (t > 1.0) t = 1.0;
+    float a = (float)t;
+
+    const FrameMotion& p = frame.previous;
+    const FrameMotion& m = frame.motion;
+    out.time = p.time + (m.time - p.time) * t;
+    out.cars.resize(m.cars.size());
+    for (size_t i = 0; i < m.cars.size(); i++) {
+        out.cars[i].position = lerp(p.cars[i].position, m.cars[i].position, a);
+        out.cars[i].door = lerp(p.cars[i].door, m.cars[i].door, a);
+    }
+    out.personX = frame.smoothPerson ? lerp(p.personX, m.personX, a) : m.personX;
+    out.personY = frame.smoothPerson ? lerp(p.personY, m.personY, a) : m.personY;
+}
+
+static void simLoop(SimThread& st) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(SIM_DT));
+    const Clock::duration maxLag = std::chrono::milliseconds(250); // I pri 1000x najvise 15000 koraka odjednom
+
+    App& app = st.app;
+    Clock::time_point next = Clock::now();
+
+    // Objava: novo stanje, a poslednja objava postaje prethodno
+    Clock::time_point lastStep = next;
+    auto publish = [&](Clock::time_point stepTime) {
+        FrameState& frame = st.frames.writeBuffer();
+        captureFrame(app, frame, st.last);
+        frame.stepTime = stepTime;
+        frame.stepPeriod = std::chrono::duration<double>(stepTime - lastStep).count();
+        lastStep = stepTime;
+
+        st.last.motion = frame.motion;
+        st.last.personInLift = frame.personInLift;
+        st.last.width = frame.width;
+        st.last.height = frame.height;
+        st.frames.publish();
+    };
+    publish(next);
+
+    // Primenjuje ulaz koji je stigao do trenutka boundary
+    auto drainInputs = [&](Clock::time_point boundary) {
+        bool any = false;
+        for (const TimedInput* in = st.inputs.front(); in && in->time <= boundary; in = st.inputs.front()) {
+            InputRecord r = in->record;
+            st.inputs.pop();
+            r.tick = (uint64_t)app.ticks;
+            writeRecord(st.recorder, r);
+            applyInput(app, r);
+            any = true;
+        }
+        return any;
+    };
+
+    while (st.running.load(std::memory_order_acquire)) {
+        if (st.saveRequested.exchange(false)) {
+            if (saveSnapshot(st.snapshotPath, app)) std::cout << "Stanje sacuvano: " << st.snapshotPath << std::endl;
+            else std::cout << "Ne mogu da sacuvam " << st.snapshotPath << std::endl;
+        }
+
+        // Koraci koji su dospeli po satu; posle zastoja ne juri izgubljeno vreme
+        Clock::time_point now = Clock::now();
+        if (now - next > maxLag) next = now;
+        bool changed = false;
+        Clock::time_point stepTime = next;
+        while (next <= now) {
+            changed |= drainInputs(next);
+            for (int k = stepsPerTick(app); k > 0; k--) stepRecorded(app, st.recorder);
+            stepTime = next;
+            next += step;
+            changed = true;
+        }
+
+        if (changed) publish(stepTime);
+        std::this_thread::sleep_until(next + step * (st.ticksPerWake - 1));
+    }
+    drainInputs(Clock::now());
+    closeRecording(st.recorder, app);
+}
+
+void startSimThread(SimThread& st, uint64_t seed, const std::string& logPath, const std::string& snapshotPath,
+                    int ticksPerWake) {
+    initApp(st.app, seed);
+    st.snapshotPath = snapshotPath;
+    st.ticksPerWake = (ticksPerWake < 1) ? 1 : ticksPerWake;
+    if (!logPath.empty() && !openRecording(st.recorder, logPath, st.app)) {
+        std::cout << "Snimak ulaza nije otvoren: " << logPath << std::endl;
+    }
+    st.running.store(true, std::memory_order_release);
+    st.thread = std::thread(simLoop, std::ref(st));
+}
+
+void stopSimThread(SimThread& st) {
+    st.running.store(false, std::memory_order_release);
+    if (st.thread.joinable()) st.thread.join();
+}
+
+void postInput(SimThread& st, const InputRecord& record) {
+    TimedInput in;
+    in.time = std::chrono::steady_clock::now();
+    in.record = record;
+    if (!st.inputs.push(in)) st.droppedInputs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void requestSnapshot(SimThread& st) {
+    st.saveRequested.store(true);
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "App.h"
+#include "InputLog.h"
+#include "TripleBuffer.h"
+#include "SpscQueue.h"
+
+// --- NIT SIMULACIJE ---
+// App (simulacija, osoba, dugmad) zivi na svojoj niti i pravi korake od
+// SIM_DT po satu masine, nezavisno od frejmova. Posle svakog koraka objavi
+// nepromenljiv prikaz stanja (FrameState) kroz trostruki bafer; prozor crta
+// poslednji objavljeni prikaz i nikad ne dira App. Spor frejm (vsync,
+// drajver) zato ne usporava simulaciju, a korak ne ceka crtanje.
+//
+// Sa ubrzanjem vremena (App::timeScale) nit za svaki SIM_DT realnog vremena
+// napravi stepsPerTick koraka, a objavi samo stanje posle poslednjeg.
+//
+// Crtanje je jednu objavu iza simulacije: uz svako stanje ide i prethodno,
+// pa prozor (interpolateFrame) crta kabine, vrata i osobu izmedju njih po
+// tome koliko je realnog vremena proslo od objave. Kretanje je zato glatko
+// na bilo kojoj frekvenciji ekrana, a nit moze da se budi redje od frejmova
+// (ticksPerWake) bez seckanja slike.
+//
+// Ulaz iz prozora: GLFW callback samo stavi InputRecord sa vremenom
+// dolaska u red (SpscQueue.h) i vrati se. Nit prazni red na granicama
+// koraka: pred svaki korak primeni sve sto je stiglo do trenutka kad je taj
+// korak bio na redu, upise mu broj koraka, zabelezi ga u snimak (InputLog.h)
+// i tek onda napravi korak. Ulaz zato nikad ne menja stanje usred koraka ni
+// usred crtanja, a i kad nit kasni pa stize vise koraka odjednom, svaki
+// ulaz pada izmedju pravih koraka.
+
+struct CarView {
+    float position = 0.0f;      // U spratovima
+    float door = 0.0f;          // 0 = zatvorena, 1 = otvorena
+};
+
+// Ono sto se menja izmedju koraka i crta se interpolirano
+struct FrameMotion {
+    double time = 0.0;              // Simulacioni sat (s); po njemu se vrti i ventilator
+    std::vector<CarView> cars;
+    float personX = 0.0f;           // Osoba van lifta (u liftu se crta uz svoju kabinu)
+    float personY = 0.0f;
+};
+
+// Sve sto crtanje cita, kopirano iz App-a posle koraka
+struct FrameState {
+    long long tick = 0;
+    int timeScale = 1;              // Koraka po SIM_DT realnog vremena
+
+    float width = 0.0f;         // 0 = nit jos nije dobila velicinu prozora
+    float height = 0.0f;
+    float panelWidth = 0.0f;
+    float maxDoorHeight = 0.0f;
+    int floorCount = 0;
+
+    std::vector<Button> buttons;    // isPressed vec odgovara kabini ciji se panel vidi
+    unsigned int layoutVersion = 0; // App::layoutVersion; tekst se gradi ponovo samo kad se promeni
+    bool ventilationOn = false;     // Kabina ciji se panel vidi
+    bool personInLift = false;
+    int personCar = 0;
+
+    std::vector<int> waiting;       // Putnika koji cekaju, po spratu (oba smera)
+    std::vector<int> riders;        // Putnika u kabini, po kabini
+
+    FrameMotion motion;             // Posle poslednjeg koraka
+    FrameMotion previous;           // Iz prethodne objave
+    bool smoothPerson = false;      // Osoba nije usla/izasla i prozor nije promenio velicinu
+    std::chrono::steady_clock::time_point stepTime;    // Kad je poslednji korak bio na redu (sat masine)
+    double stepPeriod = SIM_DT;     // Realno vreme (s) izmedju previous i motion
+};
+
+// Ulaz sa vremenom dolaska (sat je std::chrono::steady_clock, kao i za korake)
+struct TimedInput {
+    std::chrono::steady_clock::time_point time;
+    InputRecord record;
+};
+
+const size_t INPUT_QUEUE_SIZE = 1024;
+
+struct SimThread {
+    App app;                            // Samo nit simulacije
+    InputRecorder recorder;
+    TripleBuffer<FrameState> frames;
+
+    std::thread thread;
+    std::atomic<bool> running{ false };
+
+    SpscQueue<TimedInput, INPUT_QUEUE_SIZE> inputs;    // Pise prozor, cita nit
+    std::atomic<long long> droppedInputs{ 0 };          // Ulaz odbacen jer je red bio pun
+
+    std::atomic<bool> saveRequested{ false };
+    std::string snapshotPath;
+
+    int ticksPerWake = 1;               // Koliko SIM_DT realnog vremena nit spava izmedju budjenja
+    FrameState last;                    // Samo nit: poslednja objava (bez dugmadi), za previous
+};
+
+// Pokrece nit; logPath prazan = bez snimka ulaza
+void startSimThread(SimThread& st, uint64_t seed, const std::string& logPath, const std::string& snapshotPath,
+                    int ticksPerWake = 1);
+
+// Zaustavlja nit i zatvara snimak ulaza
+void stopSimThread(SimThread& st);
+
+// Iz prozora (jedna nit): ulaz za prvu granicu koraka posle ovog trenutka
+// (tick upisuje nit). Ne ceka; ako je red pun, ulaz se odbacuje i broji.
+void postInput(SimThread& st, const InputRecord& record);
+
+// Iz prozora: nit cuva App u snapshotPath na sledecoj granici koraka
+void requestSnapshot(SimThread& st);
+
+// Prikaz stanja u FrameState (poziva ga nit posle koraka i ulaza);
+// previous je poslednja objava pre ove
+void captureFrame(const App& app, FrameState& frame, const FrameState& previous);
+
+// Stanje za crtanje u trenutku now: izmedju frame.previous i frame.motion
+void interpolateFrame(const FrameState& frame, std::chrono::steady_clock::time_point now, FrameMotion& out);
@@ -0,0 +1,477 @@
+#include "Simulation.h"
+
+#include <cmath>
+
+// Jezgro kontrolera je instancirano za svaku politiku (Dispatch.h); javne
+// funkcije na dnu fajla samo biraju varijantu po sim.policy
+template <class Policy> static int hallCall(Simulation& sim, int floor, int dir);
+template <class Policy> static void carCall(Simulation& sim, int car, int floor);
+
+void initSimulation(Simulation& sim, int floorCount, int carCount, int startFloor) {
+    if (floorCount < 2) floorCount = 2;
+    if (floorCount > RequestSet::MAX_FLOORS) floorCount = RequestSet::MAX_FLOORS;
+    if (carCount < 1) carCount = 1;
+    if (startFloor >= floorCount) startFloor = floorCount - 1;
+
+    sim = Simulation();
+    sim.floorCount = floorCount;
+    sim.hallUp.resize(floorCount);
+    sim.hallDown.resize(floorCount);
+    sim.upAssignment.assign(floorCount, -1);
+    sim.downAssignment.assign(floorCount, -1);
+    sim.waitingUp.resize(floorCount);
+    sim.waitingDown.resize(floorCount);
+    sim.cars.resize(carCount);
+    for (Car& car : sim.cars) initCar(car, floorCount, startFloor);
+    sim.riders.resize(carCount);
+    sim.stats.byFloor.resize(floorCount);
+    sim.stats.byHour.resize(HOURS_PER_DAY);
+    initScripts(sim.scripts, floorCount);
+}
+
+void setMotionProfile(Simulation& sim, const MotionProfile& motion) {
+    for (Car& car : sim.cars) car.motion = motion;
+}
+
+void setDoorDuration(Simulation& sim, double seconds) {
+    for (Car& car : sim.cars) car.doorDuration = seconds;
+}
+
+// Zbir opterecenja posle promene broja putnika ili nosivosti
+static void updateLoadFactor(Simulation& sim) {
+    sim.loadFactorSum = 0.0;
+    for (const Car& car : sim.cars) sim.loadFactorSum += (double)car.load / car.capacity;
+}
+
+void setCapacity(Simulation& sim, int passengers) {
+    if (passengers < 1) passengers = 1;
+    for (Car& car : sim.cars) car.capacity = passengers;
+    updateLoadFactor(sim);
+}
+
+double meanLoadFactor(const Simulation& sim, int hour) {
+    double load = 0.0, time = 0.0;
+    for (int h = 0; h < HOURS_PER_DAY; h++) {
+        if (hour >= 0 && h != hour) continue;
+        load += sim.metrics.loadTime[h];
+        time += sim.metrics.observedTime[h];
+    }
+    if (time <= 0.0 || sim.cars.empty()) return 0.0;
+    return load / (time * sim.cars.size());
+}
+
+// Ako kabina ima nov plan, njen sledeci dogadjaj ide u red
+static void scheduleCar(Simulation& sim, int index) {
+    Car& car = sim.cars[index];
+    if (car.version == car.queuedVersion) return;
+    car.queuedVersion = car.version;
+    if (std::isinf(car.eventTime)) return;
+
+    Event e = {};
+    e.time = car.eventTime;
+    e.car = index;
+    e.version = car.version;
+    switch (car.liftState) {
+    case DOOR_OPENING: e.type = EV_DOOR_OPENED; break;
+    case DOOR_OPEN:    e.type = EV_DWELL_END; break;
+    case DOOR_CLOSING: e.type = EV_DOOR_CLOSED; break;
+    default:           e.type = EV_FLOOR_ARRIVAL; break;
+    }
+    sim.events.push(e);
+}
+
+// Poziv je odgovoren cim bilo koja kabina otvori vrata na tom spratu u tom smeru
+static void answerHallCall(Simulation& sim, int floor, int dir) {
+    RequestSet& calls = (dir == CALL_UP) ? sim.hallUp : sim.hallDown;
+    std::vector<int>& assignment = (dir == CALL_UP) ? sim.upAssignment : sim.downAssignment;
+    if (!calls.test(floor)) return;
+
+    int assigned = assignment[floor];
+    if (assigned >= 0) {
+        Car& car = sim.cars[assigned];
+        if (dir == CALL_UP) car.hallUp.reset(floor);
+        else car.hallDown.reset(floor);
+    }
+    calls.reset(floor);
+    assignment[floor] = -1;
+}
+
+// Sat u danu u kom je putnik pozvao lift
+static int hourOfDay(double t) {
+    long long hour = (long long)(t / 3600.0);
+    return (int)(hour % HOURS_PER_DAY);
+}
+
+// Opterecenje se ne menja izmedju dogadjaja: integral do t, po satima
+static void accumulateLoad(Simulation& sim, double t) {
+    double from = sim.time;
+    while (from < t) {
+        double hourEnd = (std::floor(from / 3600.0) + 1.0) * 3600.0;
+        double to = (t < hourEnd) ? t : hourEnd;
+        int hour = hourOfDay(from);
+        sim.metrics.loadTime[hour] += sim.loadFactorSum * (to - from);
+        sim.metrics.observedTime[hour] += to - from;
+        from = to;
+    }
+}
+
+template <class Policy> static void redispatch(Simulation& sim, int car, int dir);
+
+// Putnici su usli (count > 0) ili izasli (count < 0)
+template <class Policy>
+static void addLoad(Simulation& sim, int index, int count) {
+    Car& car = sim.cars[index];
+    bool bypassed = bypassesHallCalls(car);
+    car.load += count;
+    updateLoadFactor(sim);
+
+    // Kabina se upravo napunila: njeni pozivi sa spratova idu drugim kabinama
+    if (!bypassed && bypassesHallCalls(car)) {
+        redispatch<Policy>(sim, index, CALL_UP);
+        redispatch<Policy>(sim, index, CALL_DOWN);
+    }
+}
+
+// Putnici koji cekaju na spratu gde su se vrata otvorila, u najavljenom smeru,
+// ulaze odjednom koliko ih stane: pocetak reda prelazi na kraj putnika u
+// kabini, pa se statistika i pozivi iz kabine racunaju nad tim susednim
+// delom nizova. Ostali cekaju i ponovo pozivaju lift kad se vrata zatvore.
+template <class Policy>
+static void boardPassengers(Simulation& sim, int index) {
+    Car& car = sim.cars[index];
+    int floor = car.currentFloor;
+    PassengerGroup& waiting = (car.lastDirection == CALL_UP) ? sim.waitingUp[floor] : sim.waitingDown[floor];
+    if (waiting.empty()) return;
+
+    PassengerGroup& riders = sim.riders[index];
+    size_t first = riders.size();
+    size_t room = (car.load < car.capacity) ? (size_t)(car.capacity - car.load) : 0;
+    size_t count = (waiting.size() < room) ? waiting.size() : room;
+    if (count == 0) return;
+
+    moveFront(waiting, count, riders, sim.time);
+
+    for (size_t i = first; i < first + count; i++) {
+        double wait = sim.time - riders.arrivalTime[i];
+        record(sim.stats.all.wait, wait);
+        record(sim.stats.byFloor[riders.origin[i]].wait, wait);
+        record(sim.stats.byHour[hourOfDay(riders.arrivalTime[i])].wait, wait);
+    }
+    for (size_t i = first; i < first + count; i++) carCall<Policy>(sim, index, riders.destination[i]);
+    sim.metrics.boarded += (long long)count;
+    addLoad<Policy>(sim, index, (int)count);
+}
+
+// Putnici kojima je ovo odrediste izlaze; ostali ostaju redom na pocetku nizova
+static void alightPassengers(Simulation& sim, int index) {
+    int floor = sim.cars[index].currentFloor;
+    PassengerGroup& out = sim.alighted;
+    size_t count = extractDestination(sim.riders[index], floor, out);
+    if (count == 0) return;
+    sim.cars[index].load -= (int)count;
+    updateLoadFactor(sim);
+
+    for (size_t i = 0; i < count; i++) {
+        double journey = sim.time - out.boardTime[i];
+        double total = sim.time - out.arrivalTime[i];
+        ServiceTimes& byFloor = sim.stats.byFloor[out.origin[i]];
+        ServiceTimes& byHour = sim.stats.byHour[hourOfDay(out.arrivalTime[i])];
+        record(sim.stats.all.journey, journey);
+        record(sim.stats.all.total, total);
+        record(byFloor.journey, journey);
+        record(byFloor.total, total);
+        record(byHour.journey, journey);
+        record(byHour.total, total);
+    }
+    sim.metrics.delivered += (long long)count;
+}
+
+static void scheduleArrival(Simulation& sim) {
+    if (std::isinf(sim.traffic.nextArrival)) return;
+    Event e = {};
+    e.time = sim.traffic.nextArrival;
+    e.type = EV_PASSENGER_ARRIVAL;
+    e.car = -1;
+    e.version = sim.traffic.version;
+    sim.events.push(e);
+}
+
+// Putnici koji nisu stali u kabinu ponovo pozivaju lift kad se vrata zatvore
+template <class Policy>
+static void reregisterWaiting(Simulation& sim, int floor) {
+    if (!sim.waitingUp[floor].empty() && !sim.hallUp.test(floor)) hallCall<Policy>(sim, floor, CALL_UP);
+    if (!sim.waitingDown[floor].empty() && !sim.hallDown.test(floor)) hallCall<Policy>(sim, floor, CALL_DOWN);
+}
+
+template <class Policy> static void addPassenger(Simulation& sim, const Passenger& p);
+
+template <class Policy>
+static void advanceTo(Simulation& sim, double t) {
+    while (true) {
+        // Tajmeri skripti idu pre dogadjaja u istom trenutku
+        double eventTime = sim.events.empty() ? INFINITY : sim.events.top().time;
+        double scriptTime = nextScriptTime(sim.scripts);
+        if (scriptTime <= eventTime && scriptTime <= t) {
+            accumulateLoad(sim, scriptTime);
+            sim.time = scriptTime;
+            runScriptTimers(sim.scripts, scriptTime);
+            continue;
+        }
+        if (eventTime > t) break;
+
+        Event e = sim.events.top();
+        sim.events.pop();
+        accumulateLoad(sim, e.time);
+        sim.time = e.time;
+
+        if (e.type == EV_HALL_CALL) {
+            sim.eventsProcessed++;
+            hallCall<Policy>(sim, e.floor, e.dir);
+            continue;
+        }
+        if (e.type == EV_PASSENGER_ARRIVAL) {
+            if (e.version != sim.traffic.version) continue; // Generator je restartovan
+            sim.eventsProcessed++;
+            addPassenger<Policy>(sim, nextPassenger(sim.traffic, sim.floorCount));
+            scheduleArrival(sim);
+            continue;
+        }
+
+        Car& car = sim.cars[e.car];
+        if (e.version != car.version) continue; // Plan kabine se u medjuvremenu promenio
+        sim.eventsProcessed++;
+
+        CarEvent result = handleCarEvent<Policy>(car, sim.time);
+        if (result == CAR_DOOR_OPENED) {
+            sim.metrics.stopsServed++;
+            answerHallCall(sim, car.currentFloor, car.lastDirection);
+            alightPassengers(sim, e.car);
+            boardPassengers<Policy>(sim, e.car);
+            const PassengerGroup& left = (car.lastDirection == CALL_UP) ? sim.waitingUp[car.currentFloor] : sim.waitingDown[car.currentFloor];
+            sim.metrics.leftBehind += (long long)left.size(); // Nisu stali
+            sim.scripts.now = sim.time;
+            notifyDoorOpen(sim.scripts, car.currentFloor, car.lastDirection, e.car);
+        }
+        else if (result == CAR_PASSED_OPPOSITE) {
+            sim.metrics.stopsSaved += car.passedOpposite;
+        }
+        else if (result == CAR_DOOR_CLOSED) {
+            reregisterWaiting<Policy>(sim, car.currentFloor);
+        }
+        scheduleCar(sim, e.car);
+    }
+    if (t > sim.time) {
+        accumulateLoad(sim, t);
+        sim.time = t;
+    }
+    sim.scripts.now = sim.time;
+}
+
+void advanceTo(Simulation& sim, double t) {
+    withPolicy(sim.policy, [&](auto policy) { advanceTo<decltype(policy)>(sim, t); });
+}
+
+void stepSimulation(Simulation& sim) {
+    advanceTo(sim, sim.time + SIM_DT);
+}
+
+void runSimulation(Simulation& sim, double seconds) {
+    advanceTo(sim, sim.time + seconds);
+}
+
+template <class Policy>
+static bool boardCar(Simulation& sim, int car) {
+    Car& c = sim.cars[car];
+    if (c.liftState != DOOR_OPEN && c.liftState != DOOR_OPENING) return false;
+    if (c.load >= c.capacity) return false;
+    addLoad<Policy>(sim, car, 1);
+    return true;
+}
+
+bool boardCar(Simulation& sim, int car) {
+    return withPolicy(sim.policy, [&](auto policy) { return boardCar<decltype(policy)>(sim, car); });
+}
+
+void leaveCar(Simulation& sim, int car) {
+    if (sim.cars[car].load <= 0) return;
+    sim.cars[car].load--;
+    updateLoadFactor(sim);
+}
+
+void scheduleHallCall(Simulation& sim, double t, int floor, int dir) {
+    Event e = {};
+    e.time = t;
+    e.type = EV_HALL_CALL;
+    e.car = -1;
+    e.floor = floor;
+    e.dir = dir;
+    sim.events.push(e);
+}
+
+template <class Policy>
+static void addPassenger(Simulation& sim, const Passenger& p) {
+    if (p.origin < 0 || p.origin >= sim.floorCount) return;
+    if (p.destination < 0 || p.destination >= sim.floorCount || p.destination == p.origin) return;
+
+    int dir = (p.destination > p.origin) ? CALL_UP : CALL_DOWN;
+    PassengerGroup& waiting = (dir == CALL_UP) ? sim.waitingUp[p.origin] : sim.waitingDown[p.origin];
+    pushPassenger(waiting, p);
+    sim.metrics.passengers++;
+
+    // Isti put kao dugme na spratu; ako je kabina vec tu i otvorena, ulazi odmah
+    int car = hallCall<Policy>(sim, p.origin, dir);
+    if (car >= 0 && carWithOpenDoor(sim, p.origin, dir) == car) boardPassengers<Policy>(sim, car);
+}
+
+void addPassenger(Simulation& sim, const Passenger& p) {
+    withPolicy(sim.policy, [&](auto policy) { addPassenger<decltype(policy)>(sim, p); });
+}
+
+void startTraffic(Simulation& sim, const TrafficMix& mix, uint64_t seed) {
+    startTraffic(sim.traffic, mix, seed, sim.time);
+    scheduleArrival(sim);
+}
+
+void stopTraffic(Simulation& sim) {
+    stopTraffic(sim.traffic);
+}
+
+template <class Policy>
+static int hallCall(Simulation& sim, int floor, int dir) {
+    if (floor < 0 || floor >= sim.floorCount) return -1;
+    // Sa dna se moze samo gore, sa vrha samo dole
+    if (floor == 0) dir = CALL_UP;
+    if (floor == sim.floorCount - 1) dir = CALL_DOWN;
+
+    // Kabina je vec tu sa otvorenim vratima u nasem smeru: nema sta da se poziva
+    int here = carWithOpenDoor(sim, floor, dir);
+    if (here >= 0) {
+        sim.cars[here].lastDirection = dir;
+        scheduleCar(sim, here);
+        return here;
+    }
+
+    RequestSet& calls = (dir == CALL_UP) ? sim.hallUp : sim.hallDown;
+    std::vector<int>& assignment = (dir == CALL_UP) ? sim.upAssignment : sim.downAssignment;
+    if (calls.test(floor)) return assignment[floor];
+
+    // Poziv dobija kabina koju politika najjeftinije ocenjuje; pune kabine
+    // (koje ionako prolaze pored spratova) samo ako su sve pune
+    int best = -1;
+    double bestCost = 0.0;
+    bool bestBypasses = true;
+    for (int i = 0; i < (int)sim.cars.size(); i++) {
+        bool bypasses = bypassesHallCalls(sim.cars[i]);
+        if (bypasses && !bestBypasses) continue;
+        double cost = Policy::cost(sim.cars[i], sim.time, floor, dir);
+        if (best < 0 || (bestBypasses && !bypasses) || cost < bestCost) {
+            best = i;
+            bestCost = cost;
+            bestBypasses = bypasses;
+        }
+    }
+
+    sim.metrics.hallCalls++;
+    calls.set(floor);
+    assignment[floor] = best;
+    Car& car = sim.cars[best];
+    if (dir == CALL_UP) car.hallUp.set(floor);
+    else car.hallDown.set(floor);
+    checkRequests<Policy>(car, sim.time);
+    scheduleCar(sim, best);
+    return best;
+}
+
+int hallCall(Simulation& sim, int floor, int dir) {
+    return withPolicy(sim.policy, [&](auto policy) { return hallCall<decltype(policy)>(sim, floor, dir); });
+}
+
+template <class Policy>
+static void carCall(Simulation& sim, int car, int floor) {
+    if (floor < 0 || floor >= sim.floorCount) return;
+    sim.metrics.carCalls++;
+    sim.cars[car].carCalls.set(floor);
+    checkRequests<Policy>(sim.cars[car], sim.time);
+    scheduleCar(sim, car);
+}
+
+void carCall(Simulation& sim, int car, int floor) {
+    withPolicy(sim.policy, [&](auto policy) { carCall<decltype(policy)>(sim, car, floor); });
+}
+
+bool extendDoor(Simulation& sim, int car) {
+    bool extended = extendDoor(sim.cars[car], sim.time);
+    scheduleCar(sim, car);
+    return extended;
+}
+
+void closeDoor(Simulation& sim, int car) {
+    closeDoor(sim.cars[car], sim.time);
+    scheduleCar(sim, car);
+}
+
+template <class Policy>
+static void redispatch(Simulation& sim, int car, int dir) {
+    RequestSet& calls = (dir == CALL_UP) ? sim.hallUp : sim.hallDown;
+    std::vector<int>& assignment = (dir == CALL_UP) ? sim.upAssignment : sim.downAssignment;
+    for (int f = calls.nextAbove(-1); f >= 0; f = calls.nextAbove(f)) {
+        if (assignment[f] != car) continue;
+        calls.reset(f);
+        assignment[f] = -1;
+        if (dir == CALL_UP) sim.cars[car].hallUp.reset(f);
+        else sim.cars[car].hallDown.reset(f);
+        sim.metrics.hallCalls--; // Isti poziv, samo druga kabina
+        hallCall<Policy>(sim, f, dir);
+    }
+    // Bez tih poziva kabina mozda vise nema razloga da ide dokle je krenula
+    checkRequests<Policy>(sim.cars[car], sim.time);
+    scheduleCar(sim, car);
+}
+
+template <class Policy>
+static void emergencyStop(Simulation& sim, int car) {
+    emergencyStop(sim.cars[car], sim.time);
+    scheduleCar(sim, car);
+
+    // Putnici u kabini ponovo pritiskaju svoje spratove
+    for (int destination : sim.riders[car].destination) carCall<Policy>(sim, car, destination);
+
+    // Pozivi ove kabine se ponovo dodeljuju
+    redispatch<Policy>(sim, car, CALL_UP);
+    redispatch<Policy>(sim, car, CALL_DOWN);
+}
+
+void emergencyStop(Simulation& sim, int car) {
+    withPolicy(sim.policy, [&](auto policy) { emergencyStop<decltype(policy)>(sim, car); });
+}
+
+double hallCallEta(const Simulation& sim, int floor, int dir) {
+    if (floor < 0 || floor >= sim.floorCount) return -1.0;
+    const std::vector<int>& assignment = (dir == CALL_UP) ? sim.upAssignment : sim.downAssignment;
+    int car = assignment[floor];
+    if (car < 0) return -1.0;
+    return estimatedArrival(sim.cars[car], sim.time, floor, dir);
+}
+
+int carWithOpenDoor(const Simulation& sim, int floor) {
+    for (int i = 0; i < (int)sim.cars.size(); i++) {
+        const Car& car = sim.cars[i];
+        if (car.currentFloor == floor && car.position == floor &&
+            (car.liftState == DOOR_OPEN || car.liftState == DOOR_OPENING)) return i;
+    }
+    return -1;
+}
+
+int carWithOpenDoor(const Simulation& sim, int floor, int dir) {
+    for (int i = 0; i < (int)sim.cars.size(); i++) {
+        const Car& car = sim.cars[i];
+        if (car.currentFloor != floor || car.position != floor) continue;
+        if (car.liftState != DOOR_OPEN && car.liftState != DOOR_OPENING) continue;
+        if (car.lastDirection == dir) return i;
+        // Prazna kabina moze da najavi drugi smer, ali ne ako je upravo stala
+        // zbog poziva u svom smeru (on se potvrdjuje tek kad se vrata otvore)
+        const RequestSet& announced = (car.lastDirection == CALL_UP) ? sim.hallUp : sim.hallDown;
+        if (!hasAnyCall(car) && !announced.test(floor)) return i;
+    }
+    return -1;
+}
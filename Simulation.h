@@ -0,0 +1,157 @@
+#pragma once
+#include <vector>
+#include "RequestSet.h"
+#include "Car.h"
+#include "EventQueue.h"
+#include "Traffic.h"
+#include "Crowd.h"
+#include "Script.h"
+#include "Histogram.h"
+#include "Dispatch.h"
+
+// --- HEADLESS JEZGRO SIMULACIJE ---
+// Grupni kontroler: N kabina (Car.h) koje dele pozive sa spratova.
+// Bez GLFW/OpenGL zavisnosti; vreme ide iskljucivo preko simulacionog sata.
+//
+// Simulacija je vodjena dogadjajima: advanceTo() skace iz dogadjaja u
+// dogadjaj (dolazak na sprat, vrata otvorena, isteklo stajanje, vrata
+// zatvorena, poziv ili dolazak putnika), pa dug period bez saobracaja ne
+// kosta nista. Generator saobracaja (Traffic.h) u red stavlja samo svoj
+// sledeci dolazak, pa i milioni putnika zauzimaju jedno mesto u redu.
+// Prozor je i dalje pomera fiksnim korakom SIM_DT i samo cita stanje.
+
+const int DEFAULT_FLOOR_COUNT = 8; // SU, PR, 1..6
+const int DEFAULT_CAR_COUNT = 1;
+
+const double SIM_DT = 1.0 / 60.0;   // Fiksni korak prikaza (s)
+
+// Smer poziva sa sprata
+const int CALL_UP = 1;
+const int CALL_DOWN = -1;
+
+const int HOURS_PER_DAY = 24;
+
+// Brojaci za ocenu usluge
+struct Metrics {
+    long long hallCalls = 0;        // Registrovani pozivi sa spratova
+    long long carCalls = 0;         // Registrovani pozivi iz kabina
+    long long stopsServed = 0;      // Koliko puta su se vrata otvorila (sve kabine)
+    long long stopsSaved = 0;       // Prolasci pored poziva u suprotnom smeru (neusmereni SCAN bi stao)
+    long long passengers = 0;       // Putnici koji su stigli na sprat
+    long long boarded = 0;          // Putnici koji su usli u kabinu
+    long long delivered = 0;        // Putnici koji su izasli na odredistu
+    long long leftBehind = 0;       // Putnici koji nisu stali u kabinu koja je otvorila za njih
+
+    // Opterecenje kroz vreme, po satu u danu: integral zbira (load / capacity)
+    // svih kabina po vremenu, i koliko je vremena u tom satu mereno (s)
+    double loadTime[HOURS_PER_DAY] = {};
+    double observedTime[HOURS_PER_DAY] = {};
+};
+
+// Vremena usluge putnika (s)
+struct ServiceTimes {
+    Histogram wait;                 // Poziv -> ulazak u kabinu
+    Histogram journey;              // Ulazak -> izlazak na odredistu
+    Histogram total;                // Poziv -> izlazak (vreme do odredista)
+};
+
+// Ukupno, po polaznom spratu i po satu u danu (po vremenu poziva).
+// Nizovi se alociraju u initSimulation; upis posle toga ne alocira.
+struct PassengerStats {
+    ServiceTimes all;
+    std::vector<ServiceTimes> byFloor;
+    std::vector<ServiceTimes> byHour;
+};
+
+struct Simulation {
+    int floorCount = DEFAULT_FLOOR_COUNT;
+    DispatchPolicy policy = DISPATCH_ETA;   // Politika dispecera (Dispatch.h)
+
+    double time = 0.0;              // Simulacioni sat (s)
+    long long eventsProcessed = 0;  // Broj obradjenih (nezastarelih) dogadjaja
+
+    std::vector<Car> cars;
+    EventQueue events;
+
+    // Pozivi sa spratova na koje jos niko nije odgovorio, odvojeno po smeru,
+    // i kabina kojoj je poziv dodeljen (-1 = nijedna)
+    RequestSet hallUp;
+    RequestSet hallDown;
+    std::vector<int> upAssignment;
+    std::vector<int> downAssignment;
+
+    // Putnici koji cekaju na spratu, po smeru u kom idu (Crowd.h)
+    std::vector<PassengerGroup> waitingUp;
+    std::vector<PassengerGroup> waitingDown;
+    std::vector<PassengerGroup> riders;     // Putnici u svakoj kabini
+    PassengerGroup alighted;                // Putnici koji upravo izlaze (radni prostor)
+    double loadFactorSum = 0.0;             // Zbir load / capacity svih kabina
+    TrafficGenerator traffic;
+
+    Metrics metrics;
+    PassengerStats stats;
+
+    ScriptScheduler scripts;                // Putnici kao korutine (Script.h), van snimka
+};
+
+void initSimulation(Simulation& sim, int floorCount = DEFAULT_FLOOR_COUNT,
+                    int carCount = DEFAULT_CAR_COUNT, int startFloor = 2);
+
+// Parametri svih kabina; zovu se posle initSimulation, pre prvih poziva
+// (voznja ili otvaranje koje je vec u toku ne menja plan)
+void setMotionProfile(Simulation& sim, const MotionProfile& motion);
+void setDoorDuration(Simulation& sim, double seconds);   // Koliko vrata stoje otvorena (s)
+void setCapacity(Simulation& sim, int passengers);       // Nosivost svake kabine (putnika)
+
+// Prosecno opterecenje kabina (0..1) u satu hour, ili za ceo period (hour < 0)
+double meanLoadFactor(const Simulation& sim, int hour = -1);
+
+// Obradjuje sve dogadjaje do trenutka t i pomera sat na t
+void advanceTo(Simulation& sim, double t);
+
+// Jedan korak od SIM_DT sekundi (za prikaz)
+void stepSimulation(Simulation& sim);
+
+// Vrti simulaciju "seconds" simuliranih sekundi, sto brze moze
+void runSimulation(Simulation& sim, double seconds);
+
+// Putnik iz skripte (Script.h) ulazi u kabinu sa otvorenim vratima ako ima
+// mesta (vraca false ako nema), odnosno izlazi iz nje. Menja samo
+// opterecenje; brojace putnika vode same skripte.
+bool boardCar(Simulation& sim, int car);
+void leaveCar(Simulation& sim, int car);
+
+// Zakazuje poziv sa sprata u trenutku t (dolazak putnika)
+void scheduleHallCall(Simulation& sim, double t, int floor, int dir);
+
+// Putnik stize na svoj polazni sprat u trenutku sim.time: ceka i poziva lift
+// u smeru odredista, a pri ulasku u kabinu pritiska dugme odredista
+void addPassenger(Simulation& sim, const Passenger& p);
+
+// Ukljucuje/iskljucuje generator saobracaja od trenutka sim.time
+void startTraffic(Simulation& sim, const TrafficMix& mix, uint64_t seed);
+void stopTraffic(Simulation& sim);
+
+// Poziv sa sprata u smeru dir (CALL_UP / CALL_DOWN): grupa ga dodeljuje
+// kabini koju politika sim.policy najbolje ocenjuje. Vraca indeks kabine.
+int hallCall(Simulation& sim, int floor, int dir);
+
+// Poziv iz kabine (dugme sprata na panelu)
+void carCall(Simulation& sim, int car, int floor);
+
+// Komande sa panela kabine (prosledjuju se kabini i ponovo planiraju njene dogadjaje)
+bool extendDoor(Simulation& sim, int car);
+void closeDoor(Simulation& sim, int car);
+
+// STOP u kabini: pozivi sa spratova koji su joj bili dodeljeni idu drugim kabinama
+void emergencyStop(Simulation& sim, int car);
+
+// Najava dolaska: procenjeno vreme (s) do dolaska kabine dodeljene pozivu
+// sa sprata floor u smeru dir, ili -1 ako takvog poziva nema
+double hallCallEta(const Simulation& sim, int floor, int dir);
+
+// Kabina sa otvorenim vratima na spratu, ili -1
+int carWithOpenDoor(const Simulation& sim, int floor);
+
+// Kabina otvorena na spratu koja ide (ili moze da krene) u smeru dir, ili -1
+int carWithOpenDoor(const Simulation& sim, int floor, int dir);
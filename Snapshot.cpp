@@ -0,0 +1,518 @@
+#include "Snapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// --- MAPIRANJE FAJLA (samo za citanje) ---
+
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = NULL;
+#endif
+};
+
+static void unmapFile(MappedFile& m) {
+#ifdef _WIN32
+    if (m.data) UnmapViewOfFile(m.data);
+    if (m.mapping) CloseHandle(m.mapping);
+    if (m.file != INVALID_HANDLE_VALUE) CloseHandle(m.file);
+    m.file = INVALID_HANDLE_VALUE;
+    m.mapping = NULL;
+#else
+    if (m.data) munmap((void*)m.data, m.size);
+#endif
+    m.data = nullptr;
+    m.size = 0;
+}
+
+static bool mapFile(MappedFile& m, const std::string& path) {
+#ifdef _WIN32
+    m.file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m.file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m.file, &size) || size.QuadPart == 0) { unmapFile(m); return false; }
+    m.mapping = CreateFileMappingA(m.file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!m.mapping) { unmapFile(m); return false; }
+    m.data = (const char*)MapViewOfFile(m.mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m.data) { unmapFile(m); return false; }
+    m.size = (size_t)size.QuadPart;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return false; }
+    void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+    m.data = (const char*)p;
+    m.size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+// --- ZAPIS ---
+
+struct SnapshotWriter {
+    uint32_t kind = 0;
+    std::vector<SnapshotSection> sections;
+    std::vector<const void*> data;
+    std::vector<std::vector<char>> scratch;     // Privremeni nizovi (CarRecord...) do upisa
+};
+
+template <class T>
+static void addSection(SnapshotWriter& w, uint32_t id, const T* items, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "sekcija mora biti niz prostih struktura");
+    SnapshotSection s;
+    s.id = id;
+    s.elementSize = (uint32_t)sizeof(T);
+    s.count = count;
+    w.sections.push_back(s);
+    w.data.push_back(items);
+}
+
+template <class T>
+static void addSection(SnapshotWriter& w, uint32_t id, const std::vector<T>& items) {
+    addSection(w, id, items.data(), items.size());
+}
+
+// Niz koji zivi dok se snimak ne upise (pokazivac ostaje isti i kad se scratch prosiri)
+template <class T>
+static T* scratchArray(SnapshotWriter& w, size_t count) {
+    w.scratch.emplace_back(count * sizeof(T) + 1);
+    return (T*)w.scratch.back().data();
+}
+
+static uint64_t alignUp(uint64_t offset) {
+    return (offset + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN;
+}
+
+static bool writeSnapshot(SnapshotWriter& w, const std::string& path) {
+    uint64_t pos = alignUp(sizeof(SnapshotHeader) + w.sections.size() * sizeof(SnapshotSection));
+    for (SnapshotSection& s : w.sections) {
+        s.offset = pos;
+        pos = alignUp(pos + s.count * s.elementSize);
+    }
+
+    SnapshotHeader header;
+    header.kind = w.kind;
+    header.sectionCount = (uint32_t)w.sections.size();
+    header.fileSize = pos;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)w.sections.data(), w.sections.size() * sizeof(SnapshotSection));
+
+    static const char zeros[SNAPSHOT_ALIGN] = {};
+    uint64_t written = sizeof(header) + w.sections.size() * sizeof(SnapshotSection);
+    for (size_t i = 0; i < w.sections.size(); i++) {
+        const SnapshotSection& s = w.sections[i];
+        out.write(zeros, (std::streamsize)(s.offset - written));
+        out.write((const char*)w.data[i], (std::streamsize)(s.count * s.elementSize));
+        written = s.offset + s.count * s.elementSize;
+    }
+    out.write(zeros, (std::streamsize)(header.fileSize - written));
+    return (bool)out;
+}
+
+// --- CITANJE ---
+
+struct SnapshotView {
+    MappedFile file;
+    const SnapshotHeader* header = nullptr;
+    const SnapshotSection* sections = nullptr;
+
+    ~SnapshotView() { unmapFile(file); }
+};
+
+static bool openSnapshot(SnapshotView& v, const std::string& path) {
+    if (!mapFile(v.file, path)) return false;
+    if (v.file.size < sizeof(SnapshotHeader)) return false;
+
+    v.header = (const SnapshotHeader*)v.file.data;
+    if (v.header->magic != SNAPSHOT_MAGIC || v.header->version != SNAPSHOT_VERSION) return false;
+    if (v.header->fileSize != v.file.size) return false;
+    if (sizeof(SnapshotHeader) + (uint64_t)v.header->sectionCount * sizeof(SnapshotSection) > v.file.size) return false;
+    v.sections = (const SnapshotSection*)(v.file.data + sizeof(SnapshotHeader));
+    return true;
+}
+
+// Niz iz sekcije id, direktno iz mape, ili nullptr ako sekcije nema ili joj
+// velicina elementa ili granice ne odgovaraju
+template <class T>
+static const T* findSection(const SnapshotView& v, uint32_t id, size_t& count) {
+    for (uint32_t i = 0; i < v.header->sectionCount; i++) {
+        const SnapshotSection& s = v.sections[i];
+        if (s.id != id) continue;
+        if (s.elementSize != sizeof(T) || s.offset % SNAPSHOT_ALIGN != 0) return nullptr;
+        if (s.offset > v.file.size || s.count > (v.file.size - s.offset) / sizeof(T)) return nullptr;
+        count = (size_t)s.count;
+        return (const T*)(v.file.data + s.offset);
+    }
+    return nullptr;
+}
+
+// Sekcija koja mora da ima tacno expected elemenata
+template <class T>
+static const T* findSection(const SnapshotView& v, uint32_t id, size_t expected, bool& ok) {
+    size_t count = 0;
+    const T* items = findSection<T>(v, id, count);
+    if (!items || count != expected) { ok = false; return nullptr; }
+    return items;
+}
+
+// --- SIMULATION ---
+
+static CarRecord carRecord(const Car& car) {
+    CarRecord r = {};
+    r.position = car.position;
+    r.currentFloor = car.currentFloor;
+    r.nextFloor = car.nextFloor;
+    r.liftState = car.liftState;
+    r.lastDirection = car.lastDirection;
+    r.motion = car.motion;
+    r.trip = car.trip;
+    r.passedOpposite = car.passedOpposite;
+    r.door = car.door;
+    r.doorOpenTimeStart = car.doorOpenTimeStart;
+    r.doorDuration = car.doorDuration;
+    r.extendedOnce = car.extendedOnce;
+    r.ventilationOn = car.ventilationOn;
+    r.capacity = car.capacity;
+    r.stateTime = car.stateTime;
+    r.eventTime = car.eventTime;
+    r.version = car.version;
+    r.queuedVersion = car.queuedVersion;
+    return r;
+}
+
+static void restoreCar(Car& car, const CarRecord& r) {
+    car.position = r.position;
+    car.currentFloor = r.currentFloor;
+    car.nextFloor = r.nextFloor;
+    car.liftState = (LiftState)r.liftState;
+    car.lastDirection = r.lastDirection;
+    car.motion = r.motion;
+    car.trip = r.trip;
+    car.passedOpposite = r.passedOpposite;
+    car.door = r.door;
+    car.doorOpenTimeStart = r.doorOpenTimeStart;
+    car.doorDuration = r.doorDuration;
+    car.extendedOnce = r.extendedOnce != 0;
+    car.ventilationOn = r.ventilationOn != 0;
+    car.capacity = (r.capacity > 0) ? r.capacity : CAR_CAPACITY;
+    car.stateTime = r.stateTime;
+    car.eventTime = r.eventTime;
+    car.version = r.version;
+    car.queuedVersion = r.queuedVersion;
+}
+
+static int wordsPerSet(int floorCount) { return (floorCount + 63) / 64; }
+
+static void addSimulation(SnapshotWriter& w, const Simulation& sim) {
+    const int floors = sim.floorCount;
+    const int carCount = (int)sim.cars.size();
+    const int W = wordsPerSet(floors);
+
+    SimRecord* rec = scratchArray<SimRecord>(w, 1);
+    *rec = SimRecord();
+    rec->floorCount = floors;
+    rec->carCount = carCount;
+    rec->policy = sim.policy;
+    rec->time = sim.time;
+    rec->eventsProcessed = sim.eventsProcessed;
+    rec->eventSequence = sim.events.sequence();
+    rec->traffic = sim.traffic;
+    rec->metrics = sim.metrics;
+    addSection(w, SECTION_SIM, rec, 1);
+
+    CarRecord* cars = scratchArray<CarRecord>(w, carCount);
+    uint64_t* carCalls = scratchArray<uint64_t>(w, (size_t)carCount * 3 * W);
+    for (int c = 0; c < carCount; c++) {
+        const Car& car = sim.cars[c];
+        cars[c] = carRecord(car);
+        std::memcpy(carCalls + (c * 3 + 0) * W, car.carCalls.data(), W * sizeof(uint64_t));
+        std::memcpy(carCalls + (c * 3 + 1) * W, car.hallUp.data(), W * sizeof(uint64_t));
+        std::memcpy(carCalls + (c * 3 + 2) * W, car.hallDown.data(), W * sizeof(uint64_t));
+    }
+    addSection(w, SECTION_CARS, cars, carCount);
+    addSection(w, SECTION_CAR_CALLS, carCalls, (size_t)carCount * 3 * W);
+
+    uint64_t* hallCalls = scratchArray<uint64_t>(w, 2 * W);
+    std::memcpy(hallCalls, sim.hallUp.data(), W * sizeof(uint64_t));
+    std::memcpy(hallCalls + W, sim.hallDown.data(), W * sizeof(uint64_t));
+    addSection(w, SECTION_HALL_CALLS, hallCalls, 2 * W);
+
+    int32_t* assignment = scratchArray<int32_t>(w, 2 * floors);
+    uint32_t* waitingCounts = scratchArray<uint32_t>(w, 2 * floors);
+    size_t waitingTotal = 0;
+    for (int f = 0; f < floors; f++) {
+        assignment[f] = sim.upAssignment[f];
+        assignment[floors + f] = sim.downAssignment[f];
+        waitingCounts[f] = (uint32_t)sim.waitingUp[f].size();
+        waitingCounts[floors + f] = (uint32_t)sim.waitingDown[f].size();
+        waitingTotal += sim.waitingUp[f].size() + sim.waitingDown[f].size();
+    }
+    Passenger* waiting = scratchArray<Passenger>(w, waitingTotal);
+    size_t n = 0;
+    for (int f = 0; f < floors; f++) for (size_t i = 0; i < sim.waitingUp[f].size(); i++) waiting[n++] = passengerAt(sim.waitingUp[f], i);
+    for (int f = 0; f < floors; f++) for (size_t i = 0; i < sim.waitingDown[f].size(); i++) waiting[n++] = passengerAt(sim.waitingDown[f], i);
+    addSection(w, SECTION_ASSIGNMENT, assignment, 2 * floors);
+    addSection(w, SECTION_WAITING_COUNTS, waitingCounts, 2 * floors);
+    addSection(w, SECTION_WAITING, waiting, waitingTotal);
+
+    uint32_t* riderCounts = scratchArray<uint32_t>(w, carCount);
+    size_t riderTotal = 0;
+    for (int c = 0; c < carCount; c++) {
+        riderCounts[c] = (uint32_t)sim.riders[c].size();
+        riderTotal += sim.riders[c].size();
+    }
+    Passenger* riders = scratchArray<Passenger>(w, riderTotal);
+    n = 0;
+    for (int c = 0; c < carCount; c++) for (size_t i = 0; i < sim.riders[c].size(); i++) riders[n++] = passengerAt(sim.riders[c], i);
+    addSection(w, SECTION_RIDER_COUNTS, riderCounts, carCount);
+    addSection(w, SECTION_RIDERS, riders, riderTotal);
+
+    addSection(w, SECTION_EVENTS, sim.events.data(), sim.events.size());
+
+    size_t statCount = 1 + sim.stats.byFloor.size() + sim.stats.byHour.size();
+    ServiceTimes* stats = scratchArray<ServiceTimes>(w, statCount);
+    stats[0] = sim.stats.all;
+    std::memcpy(stats + 1, sim.stats.byFloor.data(), sim.stats.byFloor.size() * sizeof(ServiceTimes));
+    std::memcpy(stats + 1 + sim.stats.byFloor.size(), sim.stats.byHour.data(), sim.stats.byHour.size() * sizeof(ServiceTimes));
+    addSection(w, SECTION_STATS, stats, statCount);
+}
+
+static bool restoreSimulation(const SnapshotView& v, Simulation& out) {
+    size_t count = 0;
+    const SimRecord* rec = findSection<SimRecord>(v, SECTION_SIM, count);
+    if (!rec || count != 1) return false;
+    if (rec->floorCount < 2 || rec->floorCount > RequestSet::MAX_FLOORS || rec->carCount < 1) return false;
+
+    const int floors = rec->floorCount;
+    const int carCount = rec->carCount;
+    const int W = wordsPerSet(floors);
+
+    bool ok = true;
+    const CarRecord* cars = findSection<CarRecord>(v, SECTION_CARS, carCount, ok);
+    const uint64_t* carCalls = findSection<uint64_t>(v, SECTION_CAR_CALLS, (size_t)carCount * 3 * W, ok);
+    const uint64_t* hallCalls = findSection<uint64_t>(v, SECTION_HALL_CALLS, 2 * W, ok);
+    const int32_t* assignment = findSection<int32_t>(v, SECTION_ASSIGNMENT, 2 * floors, ok);
+    const uint32_t* waitingCounts = findSection<uint32_t>(v, SECTION_WAITING_COUNTS, 2 * floors, ok);
+    const uint32_t* riderCounts = findSection<uint32_t>(v, SECTION_RIDER_COUNTS, carCount, ok);
+    const ServiceTimes* stats = findSection<ServiceTimes>(v, SECTION_STATS, 1 + floors + HOURS_PER_DAY, ok);
+    if (!ok) return false;
+
+    size_t waitingTotal = 0, riderTotal = 0, eventCount = 0, n = 0;
+    for (int i = 0; i < 2 * floors; i++) waitingTotal += waitingCounts[i];
+    for (int c = 0; c < carCount; c++) riderTotal += riderCounts[c];
+    const Passenger* waiting = findSection<Passenger>(v, SECTION_WAITING, waitingTotal, ok);
+    const Passenger* riders = findSection<Passenger>(v, SECTION_RIDERS, riderTotal, ok);
+    const Event* events = findSection<Event>(v, SECTION_EVENTS, eventCount);
+    if (!ok || !events) return false;
+
+    Simulation sim;
+    initSimulation(sim, floors, carCount, 2);
+    sim.policy = (DispatchPolicy)rec->policy;
+    sim.time = rec->time;
+    sim.eventsProcessed = rec->eventsProcessed;
+    sim.traffic = rec->traffic;
+    sim.metrics = rec->metrics;
+
+    for (int c = 0; c < carCount; c++) {
+        Car& car = sim.cars[c];
+        restoreCar(car, cars[c]);
+        car.carCalls.assign(carCalls + (c * 3 + 0) * W);
+        car.hallUp.assign(carCalls + (c * 3 + 1) * W);
+        car.hallDown.assign(carCalls + (c * 3 + 2) * W);
+    }
+    sim.hallUp.assign(hallCalls);
+    sim.hallDown.assign(hallCalls + W);
+
+    for (int f = 0; f < floors; f++) {
+        sim.upAssignment[f] = assignment[f];
+        sim.downAssignment[f] = assignment[floors + f];
+    }
+    for (int f = 0; f < floors; f++) {
+        assignGroup(sim.waitingUp[f], waiting + n, waitingCounts[f]);
+        n += waitingCounts[f];
+    }
+    for (int f = 0; f < floors; f++) {
+        assignGroup(sim.waitingDown[f], waiting + n, waitingCounts[floors + f]);
+        n += waitingCounts[floors + f];
+    }
+    n = 0;
+    for (int c = 0; c < carCount; c++) {
+        assignGroup(sim.riders[c], riders + n, riderCounts[c]);
+        n += riderCounts[c];
+        sim.cars[c].load = (int)riderCounts[c];
+        sim.loadFactorSum += (double)sim.cars[c].load / sim.cars[c].capacity;
+    }
+
+    sim.events.assign(events, eventCount, rec->eventSequence);
+
+    sim.stats.all = stats[0];
+    std::memcpy(sim.stats.byFloor.data(), stats + 1, floors * sizeof(ServiceTimes));
+    std::memcpy(sim.stats.byHour.data(), stats + 1 + floors, HOURS_PER_DAY * sizeof(ServiceTimes));
+
+    out = std::move(sim);
+    return true;
+}
+
+bool saveSnapshot(const std::string& path, const Simulation& sim) {
+    SnapshotWriter w;
+    w.kind = SNAPSHOT_SIMULATION;
+    addSimulation(w, sim);
+    return writeSnapshot(w, path);
+}
+
+bool loadSnapshot(const std::string& path, Simulation& sim) {
+    SnapshotView v;
+    if (!openSnapshot(v, path)) return false;
+    if (v.header->kind != SNAPSHOT_SIMULATION && v.header->kind != SNAPSHOT_APP) return false;
+    return restoreSimulation(v, sim);
+}
+
+// --- APP ---
+
+bool saveSnapshot(const std::string& path, const App& app) {
+    SnapshotWriter w;
+    w.kind = SNAPSHOT_APP;
+    addSimulation(w, app.sim);
+
+    AppRecord* rec = scratchArray<AppRecord>(w, 1);
+    *rec = AppRecord();
+    rec->seed = app.seed;
+    rec->ticks = app.ticks;
+    rec->width = app.width;
+    rec->height = app.height;
+    rec->personX = app.personX;
+    rec->personY = app.personY;
+    rec->personInLift = app.personInLift;
+    rec->personCar = app.personCar;
+    addSection(w, SECTION_APP, rec, 1);
+
+    uint8_t* pressed = scratchArray<uint8_t>(w, app.buttons.size());
+    for (size_t i = 0; i < app.buttons.size(); i++) pressed[i] = app.buttons[i].isPressed;
+    addSection(w, SECTION_BUTTONS, pressed, app.buttons.size());
+    return writeSnapshot(w, path);
+}
+
+bool loadSnapshot(const std::string& path, App& app) {
+    SnapshotView v;
+    if (!openSnapshot(v, path) || v.header->kind != SNAPSHOT_APP) return false;
+
+    size_t count = 0;
+    const AppRecord* rec = findSection<AppRecord>(v, SECTION_APP, count);
+    if (!rec || count != 1) return false;
+
+    App restored;
+    if (!restoreSimulation(v, restored.sim)) return false;
+    restored.seed = rec->seed;
+    restored.ticks = rec->ticks;
+    restored.echo = app.echo;
+
+    // Raspored dugmadi se izvodi iz velicine prozora, osoba se upisuje preko
+    resizeApp(restored, rec->width, rec->height);
+    restored.personX = rec->personX;
+    restored.personY = rec->personY;
+    restored.personInLift = rec->personInLift != 0;
+    restored.personCar = rec->personCar;
+    if (restored.personCar < 0 || restored.personCar >= (int)restored.sim.cars.size()) return false;
+
+    const uint8_t* pressed = findSection<uint8_t>(v, SECTION_BUTTONS, count);
+    if (pressed && count == restored.buttons.size()) {
+        for (size_t i = 0; i < count; i++) restored.buttons[i].isPressed = pressed[i] != 0;
+    }
+
+    app = std::move(restored);
+    return true;
+}
+
+// --- BATCHENV ---
+
+bool saveSnapshot(const std::string& path, const BatchEnv& env) {
+    SnapshotWriter w;
+    w.kind = SNAPSHOT_BATCH;
+
+    BatchRecord* rec = scratchArray<BatchRecord>(w, 1);
+    *rec = BatchRecord();
+    rec->config = env.config;
+    rec->obsSize = env.obsSize;
+    addSection(w, SECTION_BATCH, rec, 1);
+
+    addSection(w, SECTION_BATCH_POSITION, env.position);
+    addSection(w, SECTION_BATCH_DOOR, env.door);
+    addSection(w, SECTION_BATCH_TIMER, env.timer);
+    addSection(w, SECTION_BATCH_STATE, env.state);
+    addSection(w, SECTION_BATCH_DIRECTION, env.direction);
+    addSection(w, SECTION_BATCH_FLOOR, env.floor);
+    addSection(w, SECTION_BATCH_CAR_CALLS, env.carCalls);
+    addSection(w, SECTION_BATCH_HALL_UP, env.hallUp);
+    addSection(w, SECTION_BATCH_HALL_DOWN, env.hallDown);
+    addSection(w, SECTION_BATCH_RNG, env.rng);
+    addSection(w, SECTION_BATCH_STEPS, env.steps);
+    addSection(w, SECTION_BATCH_EPISODE, env.episode);
+    addSection(w, SECTION_BATCH_OBS, env.obs);
+    addSection(w, SECTION_BATCH_REWARD, env.reward);
+    addSection(w, SECTION_BATCH_DONE, env.done);
+    return writeSnapshot(w, path);
+}
+
+template <class T>
+static void copySection(const SnapshotView& v, uint32_t id, std::vector<T>& dst, bool& ok) {
+    const T* src = findSection<T>(v, id, dst.size(), ok);
+    if (src) std::memcpy(dst.data(), src, dst.size() * sizeof(T));
+}
+
+bool loadSnapshot(const std::string& path, BatchEnv& env) {
+    SnapshotView v;
+    if (!openSnapshot(v, path) || v.header->kind != SNAPSHOT_BATCH) return false;
+
+    size_t count = 0;
+    const BatchRecord* rec = findSection<BatchRecord>(v, SECTION_BATCH, count);
+    if (!rec || count != 1) return false;
+
+    // initBatch alocira nizove i racuna izvedene vrednosti (profil voznje...)
+    BatchEnv restored;
+    initBatch(restored, rec->config);
+    if (restored.obsSize != rec->obsSize) return false;
+
+    bool ok = true;
+    copySection(v, SECTION_BATCH_POSITION, restored.position, ok);
+    copySection(v, SECTION_BATCH_DOOR, restored.door, ok);
+    copySection(v, SECTION_BATCH_TIMER, restored.timer, ok);
+    copySection(v, SECTION_BATCH_STATE, restored.state, ok);
+    copySection(v, SECTION_BATCH_DIRECTION, restored.direction, ok);
+    copySection(v, SECTION_BATCH_FLOOR, restored.floor, ok);
+    copySection(v, SECTION_BATCH_CAR_CALLS, restored.carCalls, ok);
+    copySection(v, SECTION_BATCH_HALL_UP, restored.hallUp, ok);
+    copySection(v, SECTION_BATCH_HALL_DOWN, restored.hallDown, ok);
+    copySection(v, SECTION_BATCH_RNG, restored.rng, ok);
+    copySection(v, SECTION_BATCH_STEPS, restored.steps, ok);
+    copySection(v, SECTION_BATCH_EPISODE, restored.episode, ok);
+    copySection(v, SECTION_BATCH_OBS, restored.obs, ok);
+    copySection(v, SECTION_BATCH_REWARD, restored.reward, ok);
+    copySection(v, SECTION_BATCH_DONE, restored.done, ok);
+    if (!ok) return false;
+
+    env = std::move(restored);
+    return true;
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Simulation.h"
+#include "App.h"
+#include "BatchEnv.h"
+
+// --- SNIMAK STANJA ---
+// Ravan binarni fajl: zaglavlje, tabela sekcija, pa sekcije poravnate na
+// 64 bajta. Svaka sekcija je niz struktura fiksne velicine (Event,
+// Passenger, Histogram, float...) zapisanih onako kako stoje u memoriji,
+// pa se fajl mapira (mmap / MapViewOfFile) i nizovi se citaju direktno iz
+// mape; vracanje stanja je samo kopiranje nizova na svoje mesto, bez
+// ikakvog parsiranja.
+//
+// Zaglavlje nosi verziju formata, a svaka sekcija velicinu svog elementa:
+// snimak sa drugom verzijom ili drugacijim rasporedom struktura (drugi
+// kompajler, izmenjena struktura) se odbija umesto da se pogresno procita.
+// Fajl je vezan za arhitekturu na kojoj je zapisan (little-endian, x64).
+//
+// Vrste snimaka:
+//   SNAPSHOT_SIMULATION  samo Simulation (LiftSim --save / --start)
+//   SNAPSHOT_APP         Simulation + osoba, prozor i dugmad (prozor, F5)
+//   SNAPSHOT_BATCH       BatchEnv, svi nizovi svih zgrada
+
+const uint32_t SNAPSHOT_MAGIC = 0x50414E53;     // "SNAP"
+const uint32_t SNAPSHOT_VERSION = 2;
+const size_t SNAPSHOT_ALIGN = 64;
+
+enum SnapshotKind : uint32_t {
+    SNAPSHOT_SIMULATION = 1,
+    SNAPSHOT_APP = 2,
+    SNAPSHOT_BATCH = 3
+};
+
+enum SnapshotSectionId : uint32_t {
+    // Simulation
+    SECTION_SIM = 1,            // SimRecord
+    SECTION_CARS,               // CarRecord po kabini
+    SECTION_CAR_CALLS,          // uint64: za svaku kabinu carCalls, hallUp, hallDown
+    SECTION_HALL_CALLS,         // uint64: hallUp, pa hallDown
+    SECTION_ASSIGNMENT,         // int32: upAssignment, pa downAssignment
+    SECTION_WAITING_COUNTS,     // uint32: broj putnika po spratu, gore pa dole
+    SECTION_WAITING,            // Passenger, redom po SECTION_WAITING_COUNTS
+    SECTION_RIDER_COUNTS,       // uint32 po kabini
+    SECTION_RIDERS,             // Passenger, redom po kabinama
+    SECTION_EVENTS,             // Event, u redosledu heap-a
+    SECTION_STATS,              // ServiceTimes: all, byFloor..., byHour...
+
+    // App
+    SECTION_APP = 32,           // AppRecord
+    SECTION_BUTTONS,            // uint8 isPressed po dugmetu
+
+    // BatchEnv (po jedan niz za svako polje)
+    SECTION_BATCH = 64,         // BatchRecord
+    SECTION_BATCH_POSITION,
+    SECTION_BATCH_DOOR,
+    SECTION_BATCH_TIMER,
+    SECTION_BATCH_STATE,
+    SECTION_BATCH_DIRECTION,
+    SECTION_BATCH_FLOOR,
+    SECTION_BATCH_CAR_CALLS,
+    SECTION_BATCH_HALL_UP,
+    SECTION_BATCH_HALL_DOWN,
+    SECTION_BATCH_RNG,
+    SECTION_BATCH_STEPS,
+    SECTION_BATCH_EPISODE,
+    SECTION_BATCH_OBS,
+    SECTION_BATCH_REWARD,
+    SECTION_BATCH_DONE
+};
+
+struct SnapshotHeader {
+    uint32_t magic = SNAPSHOT_MAGIC;
+    uint32_t version = SNAPSHOT_VERSION;
+    uint32_t kind = 0;
+    uint32_t sectionCount = 0;
+    uint64_t fileSize = 0;
+};
+
+struct SnapshotSection {
+    uint32_t id = 0;
+    uint32_t elementSize = 0;
+    uint64_t offset = 0;        // Od pocetka fajla, deljivo sa SNAPSHOT_ALIGN
+    uint64_t count = 0;
+};
+
+// Delovi stanja koji nisu nizovi, kao strukture fiksne velicine
+struct SimRecord {
+    int32_t floorCount = 0;
+    int32_t carCount = 0;
+    int32_t policy = 0;
+    double time = 0.0;
+    long long eventsProcessed = 0;
+    unsigned long long eventSequence = 0;
+    TrafficGenerator traffic;
+    Metrics metrics;
+};
+
+struct CarRecord {
+    double position;
+    int32_t currentFloor;
+    int32_t nextFloor;
+    int32_t liftState;
+    int32_t lastDirection;
+    MotionProfile motion;
+    Trip trip;
+    int32_t passedOpposite;
+    double door;
+    double doorOpenTimeStart;
+    double doorDuration;
+    uint8_t extendedOnce;
+    uint8_t ventilationOn;
+    int32_t capacity;           // Opterecenje (load) je broj putnika u SECTION_RIDERS
+    double stateTime;
+    double eventTime;
+    uint32_t version;
+    uint32_t queuedVersion;
+};
+
+struct AppRecord {
+    uint64_t seed;
+    long long ticks;
+    float width, height;
+    float personX, personY;
+    uint8_t personInLift;
+    int32_t personCar;
+};
+
+struct BatchRecord {
+    BatchConfig config;
+    int32_t obsSize;
+};
+
+// Cuvanje i vracanje; false ako fajl ne moze da se zapise / procita ili nije
+// odgovarajuce vrste i verzije (stanje se tada ne menja)
+bool saveSnapshot(const std::string& path, const Simulation& sim);
+bool saveSnapshot(const std::string& path, const App& app);
+bool saveSnapshot(const std::string& path, const BatchEnv& env);
+
+// Simulation se moze vratiti i iz snimka prozora (deo sa osobom se preskace)
+bool loadSnapshot(const std::string& path, Simulation& sim);
+bool loadSnapshot(const std::string& path, App& app);
+bool loadSnapshot(const std::string& path, BatchEnv& env);
@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// --- RED JEDAN PISAC / JEDAN CITALAC ---
+// Prsten fiksne velicine (stepen dvojke) bez zakljucavanja: pisac pomera
+// samo tail, citalac samo head, a svaki drzi poslednju vrednost tudjeg
+// brojaca u svom kesu, pa dok red nije pun / prazan ne cita ni jedan tudji
+// atomik. Brojaci rastu neograniceno; indeks u nizu je brojac & MASK.
+// Pisac i citalac su na razlicitim linijama kesa da se ne bi otimali o njih.
+//
+// Pun red ne ceka: push vraca false i pisac odlucuje sta ce sa vrednoscu.
+
+template <class T, size_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY mora biti stepen dvojke");
+
+public:
+    // Samo pisac
+    bool push(const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - headCache == CAPACITY) {
+            headCache = head.load(std::memory_order_acquire);
+            if (t - headCache == CAPACITY) return false;
+        }
+        items[t & MASK] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Samo citalac: najstariji element ili nullptr ako je red prazan
+    const T* front() {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tailCache) {
+            tailCache = tail.load(std::memory_order_acquire);
+            if (h == tailCache) return nullptr;
+        }
+        return &items[h & MASK];
+    }
+
+    // Samo citalac, posle front() != nullptr
+    void pop() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    static const size_t MASK = CAPACITY - 1;
+
+    alignas(64) std::atomic<size_t> head{ 0 };     // Citalac pise
+    size_t tailCache = 0;                           // Citalac: poslednji procitani tail
+    alignas(64) std::atomic<size_t> tail{ 0 };     // Pisac pise
+    size_t headCache = 0;                           // Pisac: poslednji procitani head
+    alignas(64) T items[CAPACITY];
+};
@@ -0,0 +1,150 @@
+#include "StrokeFont.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define STROKE_FONT_SSE 1
+#endif
+
+size_t strokeFloatCount(std::string_view text) {
+    size_t n = 0;
+    for (char c : text) n += strokeGlyph(c).count;
+    return n * 4;
+}
+
+size_t strokeFloatCount(std::span<const StrokeLabel> labels) {
+    size_t n = 0;
+    for (const StrokeLabel& label : labels) n += strokeFloatCount(label.text);
+    return n;
+}
+
+size_t emitStrokeText(std::span<float> out, const StrokeLabel& label) {
+    float* dst = out.data();
+    float x = label.x;
+    float s = label.scale;
+#ifdef STROKE_FONT_SSE
+    const __m128 scale = _mm_set1_ps(s);
+#endif
+    for (char c : label.text) {
+        StrokeGlyph g = strokeGlyph(c);
+        const float* src = STROKE_TABLES.points + g.first * 4;
+#ifdef STROKE_FONT_SSE
+        // (x, y, x, y) + duz * scale: obe tacke duzi odjednom
+        const __m128 origin = _mm_setr_ps(x, label.y, x, label.y);
+        for (int i = 0; i < g.count; i++, src += 4, dst += 4) {
+            _mm_storeu_ps(dst, _mm_add_ps(origin, _mm_mul_ps(_mm_loadu_ps(src), scale)));
+        }
+#else
+        for (int i = 0; i < g.count; i++, src += 4, dst += 4) {
+            dst[0] = x + src[0] * s;
+            dst[1] = label.y + src[1] * s;
+            dst[2] = x + src[2] * s;
+            dst[3] = label.y + src[3] * s;
+        }
+#endif
+        x += label.advance;
+    }
+    return (size_t)(dst - out.data());
+}
+
+size_t emitStrokeLabels(std::span<float> out, std::span<const StrokeLabel> labels) {
+    size_t written = 0;
+    for (const StrokeLabel& label : labels) written += emitStrokeText(out.subspan(written), label);
+    return written;
+}
+
+// --- ATLAS (SDF) ---
+
+static float segmentDistance(float px, float py, const float* seg) {
+    float dx = seg[2] - seg[0], dy = seg[3] - seg[1];
+    float len2 = dx * dx + dy * dy;
+    float t = (len2 > 0.0f) ? ((px - seg[0]) * dx + (py - seg[1]) * dy) / len2 : 0.0f;
+    t = std::clamp(t, 0.0f, 1.0f);
+    float ex = px - (seg[0] + t * dx), ey = py - (seg[1] + t * dy);
+    return std::sqrt(ex * ex + ey * ey);
+}
+
+static void atlasCellOrigin(const StrokeAtlas& atlas, int c, int& x, int& y) {
+    int cell = c - STROKE_ATLAS_FIRST;
+    x = (cell % STROKE_ATLAS_COLUMNS) * atlas.cellWidth;
+    y = (cell / STROKE_ATLAS_COLUMNS) * atlas.cellHeight;
+}
+
+void buildStrokeAtlas(StrokeAtlas& atlas) {
+    atlas.cellWidth = (int)std::lround((1.0f + 2.0f * STROKE_ATLAS_PAD) * STROKE_ATLAS_PX);
+    atlas.cellHeight = (int)std::lround((2.0f + 2.0f * STROKE_ATLAS_PAD) * STROKE_ATLAS_PX);
+    int rows = (STROKE_ATLAS_GLYPHS + STROKE_ATLAS_COLUMNS - 1) / STROKE_ATLAS_COLUMNS;
+    atlas.width = atlas.cellWidth * STROKE_ATLAS_COLUMNS;
+    atlas.height = atlas.cellHeight * rows;
+    atlas.distance.assign((size_t)atlas.width * atlas.height, 0);
+
+    const float radius = STROKE_WIDTH * 0.5f;
+    for (int c = STROKE_ATLAS_FIRST; c < STROKE_ATLAS_FIRST + STROKE_ATLAS_GLYPHS; c++) {
+        StrokeGlyph g = STROKE_TABLES.glyphs[c];
+        if (g.count == 0) continue;
+        int cx, cy;
+        atlasCellOrigin(atlas, c, cx, cy);
+
+        for (int j = 0; j < atlas.cellHeight; j++) {
+            float py = -STROKE_ATLAS_PAD + (j + 0.5f) / STROKE_ATLAS_PX;
+            uint8_t* row = atlas.distance.data() + (size_t)(cy + j) * atlas.width + cx;
+            for (int i = 0; i < atlas.cellWidth; i++) {
+                float px = -STROKE_ATLAS_PAD + (i + 0.5f) / STROKE_ATLAS_PX;
+
+                // Najbliza duz znaka
+                float nearest = INFINITY;
+                for (int k = 0; k < g.count; k++) {
+                    nearest = std::min(nearest, segmentDistance(px, py, STROKE_TABLES.points + (g.first + k) * 4));
+                }
+
+                // Unutra > 0.5, spolja < 0.5
+                float v = 0.5f + 0.5f * (radius - nearest) / STROKE_ATLAS_RANGE;
+                row[i] = (uint8_t)std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f);
+            }
+        }
+    }
+}
+
+// Znak koji ima celiju u atlasu (mala slova kao velika); -1 ako se ne crta
+static int atlasGlyph(char c) {
+    if (c >= 'a' && c <= 'z') c = (char)(c - 'a' + 'A');
+    int u = (unsigned char)c;
+    if (u < STROKE_ATLAS_FIRST || u >= STROKE_ATLAS_FIRST + STROKE_ATLAS_GLYPHS) return -1;
+    return (STROKE_TABLES.glyphs[u].count > 0) ? u : -1;
+}
+
+size_t strokeQuadCount(std::span<const StrokeLabel> labels) {
+    size_t n = 0;
+    for (const StrokeLabel& label : labels) {
+        for (char c : label.text) n += (atlasGlyph(c) >= 0);
+    }
+    return n;
+}
+
+size_t emitGlyphQuads(std::span<GlyphQuad> out, std::span<const StrokeLabel> labels, const StrokeAtlas& atlas) {
+    size_t n = 0;
+    for (const StrokeLabel& label : labels) {
+        float x = label.x;
+        for (char c : label.text) {
+            int glyph = atlasGlyph(c);
+            if (glyph >= 0) {
+                int cx, cy;
+                atlasCellOrigin(atlas, glyph, cx, cy);
+                GlyphQuad& q = out[n++];
+                q.x = x - STROKE_ATLAS_PAD * label.scale;
+                q.y = label.y - STROKE_ATLAS_PAD * label.scale;
+                q.w = atlas.cellWidth * label.scale / STROKE_ATLAS_PX;
+                q.h = atlas.cellHeight * label.scale / STROKE_ATLAS_PX;
+                q.u0 = (float)cx / atlas.width;
+                q.v0 = (float)cy / atlas.height;
+                q.u1 = (float)(cx + atlas.cellWidth) / atlas.width;
+                q.v1 = (float)(cy + atlas.cellHeight) / atlas.height;
+                q.pxRange = 2.0f * STROKE_ATLAS_RANGE * label.scale;
+            }
+            x += label.advance;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// --- VEKTORSKI FONT (DUZI) ---
+// Svaki znak je niz duzi u kvadratu 1 x 2 (x udesno, y nagore), zapisan kao
+// podaci u STROKE_FONT. Tabele (odakle pocinju duzi kog znaka i sve tacke
+// redom) prave se pri prevodjenju, pa ispis natpisa nije switch po znaku
+// nego pretraga u tabeli i kopiranje duzi uz skaliranje i pomeranje u
+// unapred alociran prostor. Nov znak je samo nov red u STROKE_FONT.
+//
+// Duz ima 4 broja (x1, y1, x2, y2); na izlazu su to dva verteksa za GL_LINES.
+
+struct StrokeSegment {
+    char glyph;
+    float x1, y1, x2, y2;
+};
+
+// Duzi istog znaka moraju biti jedna za drugom (proverava se pri prevodjenju)
+constexpr StrokeSegment STROKE_FONT[] = {
+    // CIFRE
+    { '0', 0, 0, 1, 0 }, { '0', 1, 0, 1, 2 }, { '0', 1, 2, 0, 2 }, { '0', 0, 2, 0, 0 },
+    { '1', 0.5f, 0, 0.5f, 2 },
+    { '2', 0, 2, 1, 2 }, { '2', 1, 2, 1, 1 }, { '2', 1, 1, 0, 1 }, { '2', 0, 1, 0, 0 }, { '2', 0, 0, 1, 0 },
+    { '3', 0, 2, 1, 2 }, { '3', 1, 2, 1, 0 }, { '3', 1, 0, 0, 0 }, { '3', 0, 1, 1, 1 },
+    { '4', 0, 2, 0, 1 }, { '4', 0, 1, 1, 1 }, { '4', 1, 0, 1, 2 },
+    { '5', 1, 2, 0, 2 }, { '5', 0, 2, 0, 1 }, { '5', 0, 1, 1, 1 }, { '5', 1, 1, 1, 0 }, { '5', 1, 0, 0, 0 },
+    { '6', 1, 2, 0, 2 }, { '6', 0, 2, 0, 0 }, { '6', 0, 0, 1, 0 }, { '6', 1, 0, 1, 1 }, { '6', 1, 1, 0, 1 },
+    { '7', 0, 2, 1, 2 }, { '7', 1, 2, 0.5f, 0 },
+    { '8', 0, 0, 1, 0 }, { '8', 1, 0, 1, 2 }, { '8', 1, 2, 0, 2 }, { '8', 0, 2, 0, 0 }, { '8', 0, 1, 1, 1 },
+    { '9', 0, 0, 1, 0 }, { '9', 1, 0, 1, 2 }, { '9', 1, 2, 0, 2 }, { '9', 0, 2, 0, 1 }, { '9', 0, 1, 1, 1 },
+
+    // SLOVA
+    { 'A', 0, 0, 0, 2 }, { 'A', 0, 2, 1, 2 }, { 'A', 1, 2, 1, 0 }, { 'A', 0, 1, 1, 1 },
+    { 'B', 0, 0, 0, 2 }, { 'B', 0, 2, 0.8f, 2 }, { 'B', 0.8f, 2, 1, 1.5f }, { 'B', 1, 1.5f, 0.8f, 1 },
+    { 'B', 0.8f, 1, 0, 1 }, { 'B', 0.8f, 1, 1, 0.5f }, { 'B', 1, 0.5f, 0.8f, 0 }, { 'B', 0.8f, 0, 0, 0 },
+    { 'C', 1, 2, 0, 2 }, { 'C', 0, 2, 0, 0 }, { 'C', 0, 0, 1, 0 },
+    { 'D', 0, 0, 0, 2 }, { 'D', 0, 2, 0.6f, 2 }, { 'D', 0.6f, 2, 1, 1 }, { 'D', 1, 1, 0.6f, 0 }, { 'D', 0.6f, 0, 0, 0 },
+    { 'E', 1, 0, 0, 0 }, { 'E', 0, 0, 0, 2 }, { 'E', 0, 2, 1, 2 }, { 'E', 0, 1, 1, 1 },
+    { 'F', 0, 0, 0, 2 }, { 'F', 0, 2, 1, 2 }, { 'F', 0, 1, 1, 1 },
+    { 'G', 1, 2, 0, 2 }, { 'G', 0, 2, 0, 0 }, { 'G', 0, 0, 1, 0 }, { 'G', 1, 0, 1, 1 },
+    { 'H', 0, 0, 0, 2 }, { 'H', 1, 0, 1, 2 }, { 'H', 0, 1, 1, 1 },
+    { 'I', 0.5f, 0, 0.5f, 2 }, { 'I', 0, 0, 1, 0 }, { 'I', 0, 2, 1, 2 },
+    { 'J', 1, 2, 1, 0 }, { 'J', 1, 0, 0, 0 }, { 'J', 0, 0, 0, 0.5f },
+    { 'K', 0, 0, 0, 2 }, { 'K', 0, 1, 1, 2 }, { 'K', 0, 1, 1, 0 },
+    { 'L', 0, 2, 0, 0 }, { 'L', 0, 0, 1, 0 },
+    { 'M', 0, 0, 0, 2 }, { 'M', 0, 2, 0.5f, 1 }, { 'M', 0.5f, 1, 1, 2 }, { 'M', 1, 2, 1, 0 },
+    { 'N', 0, 0, 0, 2 }, { 'N', 0, 2, 1, 0 }, { 'N', 1, 0, 1, 2 },
+    { 'O', 0, 0, 1, 0 }, { 'O', 1, 0, 1, 2 }, { 'O', 1, 2, 0, 2 }, { 'O', 0, 2, 0, 0 },
+    { 'P', 0, 0, 0, 2 }, { 'P', 0, 2, 1, 2 }, { 'P', 1, 2, 1, 1 }, { 'P', 1, 1, 0, 1 },
+    { 'Q', 0, 0, 1, 0 }, { 'Q', 1, 0, 1, 2 }, { 'Q', 1, 2, 0, 2 }, { 'Q', 0, 2, 0, 0 }, { 'Q', 0.5f, 0.5f, 1, 0 },
+    { 'R', 0, 0, 0, 2 }, { 'R', 0, 2, 1, 2 }, { 'R', 1, 2, 1, 1 }, { 'R', 0, 1, 1, 0 }, { 'R', 0.5f, 1, 1, 0 },
+    { 'S', 1, 2, 0, 2 }, { 'S', 0, 2, 0, 1 }, { 'S', 0, 1, 1, 1 }, { 'S', 1, 1, 1, 0 }, { 'S', 1, 0, 0, 0 },
+    { 'T', 0.5f, 0, 0.5f, 2 }, { 'T', 0, 2, 1, 2 },
+    { 'U', 0, 2, 0, 0 }, { 'U', 0, 0, 1, 0 }, { 'U', 1, 0, 1, 2 },
+    { 'V', 0, 2, 0.5f, 0 }, { 'V', 0.5f, 0, 1, 2 },
+    { 'W', 0, 2, 0.25f, 0 }, { 'W', 0.25f, 0, 0.5f, 1 }, { 'W', 0.5f, 1, 0.75f, 0 }, { 'W', 0.75f, 0, 1, 2 },
+    { 'X', 0, 0, 1, 2 }, { 'X', 0, 2, 1, 0 },
+    { 'Y', 0, 2, 0.5f, 1 }, { 'Y', 1, 2, 0.5f, 1 }, { 'Y', 0.5f, 1, 0.5f, 0 },
+    { 'Z', 0, 2, 1, 2 }, { 'Z', 1, 2, 0, 0 }, { 'Z', 0, 0, 1, 0 },
+    { '/', 0, 0, 1, 2 },
+};
+
+const int STROKE_SEGMENT_COUNT = (int)(sizeof(STROKE_FONT) / sizeof(STROKE_FONT[0]));
+const int STROKE_GLYPH_TABLE = 128;     // ASCII; ostali znaci (i razmak) nemaju duzi
+
+struct StrokeGlyph {
+    uint16_t first = 0;         // Prva duz u StrokeTables::points
+    uint16_t count = 0;
+};
+
+struct StrokeTables {
+    StrokeGlyph glyphs[STROKE_GLYPH_TABLE] = {};
+    float points[STROKE_SEGMENT_COUNT * 4] = {};    // x1, y1, x2, y2 po duzi, redom kao STROKE_FONT
+};
+
+constexpr StrokeTables buildStrokeTables() {
+    StrokeTables t{};
+    for (int i = 0; i < STROKE_SEGMENT_COUNT; i++) {
+        const StrokeSegment& s = STROKE_FONT[i];
+        StrokeGlyph& g = t.glyphs[(unsigned char)s.glyph];
+        if (g.count == 0) g.first = (uint16_t)i;
+        g.count++;
+        t.points[i * 4 + 0] = s.x1;
+        t.points[i * 4 + 1] = s.y1;
+        t.points[i * 4 + 2] = s.x2;
+        t.points[i * 4 + 3] = s.y2;
+    }
+    return t;
+}
+
+constexpr bool strokeGlyphsContiguous() {
+    for (int i = 0; i < STROKE_SEGMENT_COUNT; i++) {
+        if ((unsigned char)STROKE_FONT[i].glyph >= STROKE_GLYPH_TABLE) return false;
+        for (int j = i + 2; j < STROKE_SEGMENT_COUNT; j++) {
+            if (STROKE_FONT[j].glyph == STROKE_FONT[i].glyph && STROKE_FONT[j - 1].glyph != STROKE_FONT[i].glyph) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(strokeGlyphsContiguous(), "STROKE_FONT: duzi jednog znaka moraju biti zajedno (ASCII)");
+
+inline constexpr StrokeTables STROKE_TABLES = buildStrokeTables();
+
+// Duzi znaka c (mala slova se crtaju kao velika)
+constexpr StrokeGlyph strokeGlyph(char c) {
+    if (c >= 'a' && c <= 'z') c = (char)(c - 'a' + 'A');
+    unsigned char u = (unsigned char)c;
+    return (u < STROKE_GLYPH_TABLE) ? STROKE_TABLES.glyphs[u] : StrokeGlyph{};
+}
+
+// Jedan natpis: znak i ide na (x + i * advance, y), velicine scale po jedinici fonta
+struct StrokeLabel {
+    std::string_view text;
+    float x = 0.0f;
+    float y = 0.0f;
+    float scale = 1.0f;
+    float advance = 0.0f;
+};
+
+// Koliko brojeva (float) natpis(i) zauzima na izlazu: 4 po duzi
+size_t strokeFloatCount(std::string_view text);
+size_t strokeFloatCount(std::span<const StrokeLabel> labels);
+
+// Kopira duzi natpisa u out (mora imati strokeFloatCount mesta), skalirane i
+// pomerene; vraca broj upisanih brojeva. Na x86/x64 duz je jedan SSE registar
+// (x1, y1, x2, y2), pa je transformacija jedno mnozenje i sabiranje po duzi.
+size_t emitStrokeText(std::span<float> out, const StrokeLabel& label);
+size_t emitStrokeLabels(std::span<float> out, std::span<const StrokeLabel> labels);
+
+// --- ATLAS (SDF) ---
+// Isti znakovi kao tekstura: za svaki znak celija sa udaljenoscu do poteza
+// (duz debljine STROKE_WIDTH), jedan kanal po tekselu, pravi se pri
+// pokretanju. Shader (text.frag) prag 0.5 pretvara u ivicu sirine jednog
+// piksela, pa natpis ostaje gladak i kad se uveca. Potezi su duzi sa
+// zaobljenim krajevima, pa jedna udaljenost opisuje oblik; ostri uglovi
+// (koje bi cuvao tek MSDF) se ne javljaju. Znak se crta kao jedan
+// cetvorougao (GlyphQuad).
+const int STROKE_ATLAS_PX = 24;             // Teksela po jedinici fonta
+const float STROKE_ATLAS_PAD = 0.375f;      // Prazno oko kvadrata 1 x 2 (jedinica); ivica celije je sigurno van poteza
+const float STROKE_ATLAS_RANGE = 0.25f;     // Udaljenost (jedinica) od ivice na kojoj teksel dostigne 0 ili 255
+const float STROKE_WIDTH = 0.2f;            // Debljina poteza (jedinica)
+const int STROKE_ATLAS_FIRST = 32;          // Prvi znak u atlasu (razmak)
+const int STROKE_ATLAS_GLYPHS = 96;         // Znakovi 32..127
+const int STROKE_ATLAS_COLUMNS = 16;
+
+struct StrokeAtlas {
+    int width = 0;                  // Teksela
+    int height = 0;
+    int cellWidth = 0;
+    int cellHeight = 0;
+    std::vector<uint8_t> distance;  // Bajt po tekselu, red po red odozdo (y nagore, kao u OpenGL-u)
+};
+
+void buildStrokeAtlas(StrokeAtlas& atlas);
+
+// Jedan znak na ekranu: pravougaonik celije, njeno mesto u atlasu i koliko
+// piksela ekrana zauzima opseg udaljenosti (za ostrinu ivice u shader-u)
+struct GlyphQuad {
+    float x, y, w, h;
+    float u0, v0, u1, v1;
+    float pxRange;
+};
+
+// Broj znakova koji se crtaju (razmak i nepoznati znakovi se preskacu)
+size_t strokeQuadCount(std::span<const StrokeLabel> labels);
+
+// Cetvorouglovi natpisa u out (mora imati strokeQuadCount mesta); vraca broj upisanih
+size_t emitGlyphQuads(std::span<GlyphQuad> out, std::span<const StrokeLabel> labels, const StrokeAtlas& atlas);
@@ -0,0 +1,110 @@
+#include "Sweep.h"
+#include "Snapshot.h"
+
+#include <atomic>
+#include <thread>
+
+std::vector<Scenario> expandGrid(const SweepGrid& grid) {
+    const Scenario& base = grid.base;
+    std::vector<int> cars = grid.cars.empty() ? std::vector<int>{ base.cars } : grid.cars;
+    std::vector<DispatchPolicy> policies = grid.policies.empty() ? std::vector<DispatchPolicy>{ base.policy } : grid.policies;
+    std::vector<double> doors = grid.doorDurations.empty() ? std::vector<double>{ base.doorDuration } : grid.doorDurations;
+    std::vector<double> speeds = grid.speeds.empty() ? std::vector<double>{ base.motion.maxSpeed } : grid.speeds;
+    std::vector<int> capacities = grid.capacities.empty() ? std::vector<int>{ base.capacity } : grid.capacities;
+    std::vector<uint64_t> seeds = grid.seeds.empty() ? std::vector<uint64_t>{ base.seed } : grid.seeds;
+
+    std::vector<Scenario> scenarios;
+    scenarios.reserve(cars.size() * policies.size() * doors.size() * speeds.size() * capacities.size() * seeds.size());
+    for (int c : cars)
+        for (DispatchPolicy p : policies)
+            for (double d : doors)
+                for (double v : speeds)
+                    for (int q : capacities)
+                        for (uint64_t seed : seeds) {
+                            Scenario s = base;
+                            s.cars = c;
+                            s.policy = p;
+                            s.doorDuration = d;
+                            s.motion.maxSpeed = v;
+                            s.capacity = q;
+                            s.seed = seed;
+                            scenarios.push_back(s);
+                        }
+    return scenarios;
+}
+
+bool initScenario(Simulation& sim, const Scenario& scenario) {
+    if (scenario.start.empty()) {
+        initSimulation(sim, scenario.floors, scenario.cars, 2);
+    }
+    else {
+        if (!loadSnapshot(scenario.start, sim)) return false;
+        sim.metrics = Metrics();
+        sim.stats.all = ServiceTimes();
+        for (ServiceTimes& t : sim.stats.byFloor) t = ServiceTimes();
+        for (ServiceTimes& t : sim.stats.byHour) t = ServiceTimes();
+    }
+    sim.policy = scenario.policy;
+    setMotionProfile(sim, scenario.motion);
+    setDoorDuration(sim, scenario.doorDuration);
+    setCapacity(sim, scenario.capacity);
+    startTraffic(sim, scenario.traffic, scenario.seed);
+    return true;
+}
+
+ScenarioResult runScenario(const Scenario& scenario) {
+    ScenarioResult result;
+    result.scenario = scenario;
+
+    Simulation sim;
+    if (!initScenario(sim, scenario)) return result;
+    long long eventsBefore = sim.eventsProcessed;
+    advanceTo(sim, sim.time + scenario.hours * 3600.0);
+
+    result.ok = true;
+    result.metrics = sim.metrics;
+    result.events = sim.eventsProcessed - eventsBefore;
+    result.times = sim.stats.all;
+    result.loadFactor = meanLoadFactor(sim);
+    return result;
+}
+
+std::vector<ScenarioResult> runSweep(const std::vector<Scenario>& scenarios, int threads) {
+    std::vector<ScenarioResult> results(scenarios.size());
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    if (threads > (int)scenarios.size()) threads = (int)scenarios.size();
+
+    // Svaka nit uzima sledecu kombinaciju dok ih ima
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < scenarios.size(); i = next++) {
+            results[i] = runScenario(scenarios[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++) pool.emplace_back(worker);
+    worker(); // I pozivajuca nit radi
+    for (std::thread& t : pool) t.join();
+    return results;
+}
+
+void writeSweepCsv(std::ostream& out, const std::vector<ScenarioResult>& results) {
+    out << "floors,cars,policy,door_s,speed_mps,capacity,rate_ph,seed,hours,"
+           "passengers,delivered,hall_calls,stops,stops_saved,left_behind,load_mean,events,"
+           "wait_mean,wait_p50,wait_p95,wait_p99,wait_max,journey_mean,journey_p95,total_mean,total_p95\n";
+    for (const ScenarioResult& r : results) {
+        if (!r.ok) continue;
+        const Scenario& s = r.scenario;
+        const ServiceTimes& t = r.times;
+        out << s.floors << ',' << s.cars << ',' << policyName(s.policy) << ',' << s.doorDuration << ','
+            << s.motion.maxSpeed << ',' << s.capacity << ',' << s.traffic.rate << ',' << s.seed << ',' << s.hours << ','
+            << r.metrics.passengers << ',' << r.metrics.delivered << ',' << r.metrics.hallCalls << ','
+            << r.metrics.stopsServed << ',' << r.metrics.stopsSaved << ',' << r.metrics.leftBehind << ','
+            << r.loadFactor << ',' << r.events << ','
+            << mean(t.wait) << ',' << percentile(t.wait, 50) << ',' << percentile(t.wait, 95) << ','
+            << percentile(t.wait, 99) << ',' << t.wait.max << ',' << mean(t.journey) << ','
+            << percentile(t.journey, 95) << ',' << mean(t.total) << ',' << percentile(t.total, 95) << '\n';
+    }
+}
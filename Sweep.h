@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <ostream>
+#include <string>
+#include "Simulation.h"
+
+// --- PRETRAGA PARAMETARA ---
+// Svaka kombinacija parametara je nezavisna simulacija sa sopstvenim
+// saobracajem (isti seed = isti putnici za sve kombinacije). Kombinacije se
+// dele nitima preko zajednickog brojaca, a rezultat svake ide u svoje mesto
+// u nizu, pa izlaz ne zavisi od broja niti ni od redosleda zavrsavanja.
+
+struct Scenario {
+    int floors = DEFAULT_FLOOR_COUNT;
+    int cars = DEFAULT_CAR_COUNT;
+    DispatchPolicy policy = DISPATCH_ETA;
+    double doorDuration = DOOR_DURATION;
+    int capacity = CAR_CAPACITY;    // Putnika po kabini
+    MotionProfile motion;
+    TrafficMix traffic;
+    uint64_t seed = 1;
+    double hours = 24.0;            // Koliko se vrti (od pocetka ili od snimka)
+    std::string start;              // Snimak (Snapshot.h) od kog se krece; prazno = prazna zgrada
+};
+
+struct ScenarioResult {
+    Scenario scenario;
+    bool ok = false;                // false: snimak scenario.start nije mogao da se procita, nista nije mereno
+    Metrics metrics;
+    long long events = 0;
+    ServiceTimes times;
+    double loadFactor = 0.0;        // Prosecno opterecenje kabina (meanLoadFactor)
+};
+
+// Mreza vrednosti; prazan niz znaci "samo vrednost iz base"
+struct SweepGrid {
+    Scenario base;
+    std::vector<int> cars;
+    std::vector<DispatchPolicy> policies;
+    std::vector<double> doorDurations;
+    std::vector<double> speeds;
+    std::vector<int> capacities;
+    std::vector<uint64_t> seeds;
+};
+
+// Sve kombinacije, seed se menja najbrze
+std::vector<Scenario> expandGrid(const SweepGrid& grid);
+
+// Zgrada spremna za pokretanje: prazna, ili stanje iz scenario.start (spratovi,
+// kabine, putnici u toku) sa politikom, vratima, nosivoscu, kinematikom i saobracajem
+// iz scenarija. Brojaci i vremena se nuliraju, pa mere samo nastavak.
+// Vraca false ako snimak ne moze da se procita.
+bool initScenario(Simulation& sim, const Scenario& scenario);
+
+// Ako initScenario ne uspe, rezultat ima ok = false i prazne brojace
+ScenarioResult runScenario(const Scenario& scenario);
+
+// threads <= 0: koliko jezgara masina ima
+std::vector<ScenarioResult> runSweep(const std::vector<Scenario>& scenarios, int threads = 0);
+
+// Jedan red po kombinaciji (CSV sa zaglavljem); neuspele kombinacije (ok = false)
+// se preskacu, da prazna zgrada ne izgleda kao izmeren rezultat
+void writeSweepCsv(std::ostream& out, const std::vector<ScenarioResult>& results);
@@ -0,0 +1,81 @@
+#include "Traffic.h"
+
+#include <cmath>
+#include <limits>
+
+TrafficMix trafficMix(TrafficPattern pattern, double ratePerHour, int lobby) {
+    TrafficMix mix;
+    mix.rate = ratePerHour;
+    mix.lobby = lobby;
+    switch (pattern) {
+    case TRAFFIC_INTERFLOOR: mix.incoming = 0.0;  mix.outgoing = 0.0;  break;
+    case TRAFFIC_UP_PEAK:    mix.incoming = 0.85; mix.outgoing = 0.05; break;
+    case TRAFFIC_DOWN_PEAK:  mix.incoming = 0.05; mix.outgoing = 0.85; break;
+    case TRAFFIC_LUNCH:      mix.incoming = 0.40; mix.outgoing = 0.40; break;
+    default:                 mix.rate = 0.0; break;
+    }
+    mix.interfloor = 1.0 - mix.incoming - mix.outgoing;
+    return mix;
+}
+
+// Eksponencijalni razmak izmedju dolazaka (s) za zadati broj putnika na sat
+static double arrivalGap(TrafficGenerator& gen) {
+    if (gen.mix.rate <= 0.0) return std::numeric_limits<double>::infinity();
+    return -std::log(1.0 - gen.rng.uniform()) * 3600.0 / gen.mix.rate;
+}
+
+void startTraffic(TrafficGenerator& gen, const TrafficMix& mix, uint64_t seed, double t) {
+    gen.mix = mix;
+    gen.rng.state = seed;
+    gen.version++;
+    gen.nextArrival = t + arrivalGap(gen);
+}
+
+void stopTraffic(TrafficGenerator& gen) {
+    gen.mix.rate = 0.0;
+    gen.version++;
+    gen.nextArrival = std::numeric_limits<double>::infinity();
+}
+
+// Slucajan sprat razlicit od "except"
+static int floorOtherThan(Rng& rng, int floorCount, int except) {
+    int f = rng.below(floorCount - 1);
+    return (f >= except) ? f + 1 : f;
+}
+
+Passenger nextPassenger(TrafficGenerator& gen, int floorCount) {
+    int lobby = gen.mix.lobby;
+    if (lobby < 0) lobby = 0;
+    if (lobby >= floorCount) lobby = floorCount - 1;
+
+    Passenger p;
+    p.arrivalTime = gen.nextArrival;
+
+    double u = gen.rng.uniform();
+    if (u < gen.mix.incoming) {
+        p.origin = lobby;
+        p.destination = floorOtherThan(gen.rng, floorCount, lobby);
+    }
+    else if (u < gen.mix.incoming + gen.mix.outgoing) {
+        p.origin = floorOtherThan(gen.rng, floorCount, lobby);
+        p.destination = lobby;
+    }
+    else if (floorCount >= 3) {
+        // Izmedju spratova: ni polazak ni odrediste nisu prizemlje
+        p.origin = floorOtherThan(gen.rng, floorCount, lobby);
+        int low = (lobby < p.origin) ? lobby : p.origin;
+        int high = (lobby < p.origin) ? p.origin : lobby;
+        int f = gen.rng.below(floorCount - 2);
+        if (f >= low) f++;
+        if (f >= high) f++;
+        p.destination = f;
+    }
+    else {
+        p.origin = gen.rng.below(floorCount);
+        p.destination = floorOtherThan(gen.rng, floorCount, p.origin);
+    }
+
+    gen.generated++;
+    gen.nextArrival += arrivalGap(gen);
+    return p;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+
+// --- GENERATOR SAOBRACAJA ---
+// Putnici sa polaznim i odredisnim spratom, dolasci po Poissonovom procesu.
+// Mesavina odredjuje koliko putnika ulazi u zgradu (iz prizemlja nagore),
+// izlazi (nadole do prizemlja) i putuje izmedju spratova. Generator ima
+// sopstveni RNG, pa isti seed daje isti saobracaj na svakoj platformi
+// (std::*_distribution nisu isti u MSVC-u i libstdc++-u).
+
+// SplitMix64: mali, brz i potpuno odredjen generator slucajnih brojeva
+struct Rng {
+    uint64_t state = 0;
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniformno u [0, 1)
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Uniformno u [0, n)
+    int below(int n) { return (int)(((next() >> 32) * (uint64_t)n) >> 32); }
+};
+
+enum TrafficPattern {
+    TRAFFIC_OFF,
+    TRAFFIC_INTERFLOOR, // Samo izmedju spratova
+    TRAFFIC_UP_PEAK,    // Jutro: vecina ulazi u zgradu
+    TRAFFIC_DOWN_PEAK,  // Kraj radnog vremena: vecina izlazi
+    TRAFFIC_LUNCH       // Pauza: ulaz i izlaz podjednako
+};
+
+struct TrafficMix {
+    double rate = 0.0;          // Putnika na sat (0 = iskljuceno)
+    double incoming = 0.0;      // Udeo putnika iz prizemlja nagore
+    double outgoing = 0.0;      // Udeo putnika sa spratova do prizemlja
+    double interfloor = 1.0;    // Udeo putnika izmedju spratova (ostatak)
+    int lobby = 1;              // Ulazni sprat (PR)
+};
+
+struct Passenger {
+    int origin = 0;
+    int destination = 0;
+    double arrivalTime = 0.0;   // Kad je putnik stigao na polazni sprat (i pozvao lift)
+    double boardTime = 0.0;     // Kad je usao u kabinu
+};
+
+struct TrafficGenerator {
+    TrafficMix mix;
+    Rng rng;
+    double nextArrival = 0.0;   // Vreme sledeceg dolaska (beskonacno ako je iskljucen)
+    unsigned int version = 0;   // Raste pri svakom restartu; stari dolasci iz reda se preskacu
+    long long generated = 0;
+};
+
+// Gotove mesavine za dati broj putnika na sat
+TrafficMix trafficMix(TrafficPattern pattern, double ratePerHour, int lobby = 1);
+
+// Pokrece generator od trenutka t (prvi dolazak je slucajan, ne u t)
+void startTraffic(TrafficGenerator& gen, const TrafficMix& mix, uint64_t seed, double t);
+void stopTraffic(TrafficGenerator& gen);
+
+// Putnik koji stize u gen.nextArrival; pomera nextArrival na sledeci dolazak
+Passenger nextPassenger(TrafficGenerator& gen, int floorCount);
@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// --- TROSTRUKI BAFER ---
+// Jedan pisac i jedan citalac razmenjuju cele vrednosti bez zakljucavanja
+// i bez cekanja. Pisac uvek ima svoj slot (back), citalac svoj (front), a
+// treci (middle) je poslednja objavljena vrednost. Objava i preuzimanje su
+// po jedna atomska zamena indeksa, pa nijedna strana ne ceka drugu: pisac
+// moze da objavi vise puta izmedju dva citanja (citalac dobija najnoviju),
+// a citalac moze da cita isti slot vise puta dok nema nove objave.
+
+template <class T>
+class TripleBuffer {
+public:
+    // Slot u koji pisac upisuje sledecu vrednost (zadrzava sadrzaj od pre
+    // dve objave, pa se nizovi u njemu ne alociraju ponovo)
+    T& writeBuffer() { return slots[back]; }
+
+    // Upisana vrednost postaje najnovija; pisac dobija slobodan slot
+    void publish() {
+        back = middle.exchange((uint8_t)(back | FRESH), std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Najnovija objavljena vrednost; vazi do sledeceg poziva read()
+    const T& read() {
+        if (middle.load(std::memory_order_acquire) & FRESH) {
+            front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        }
+        return slots[front];
+    }
+
+private:
+    static const uint8_t INDEX = 3;
+    static const uint8_t FRESH = 4;     // Middle je objavljen posle poslednjeg citanja
+
+    T slots[3];
+    uint8_t back = 0;                   // Samo pisac
+    uint8_t front = 2;                  // Samo citalac
+    std::atomic<uint8_t> middle{ 1 };
+};
@@ -0,0 +1,9 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec4 vColor; // Boja instance (rect.vert)
+
+void main()
+{
+    FragColor = vColor;
+}
@@ -0,0 +1,19 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;   // Jedinicni kvadrat (0..1)
+layout (location = 1) in vec4 aRect;  // Po instanci: x, y, width, height
+layout (location = 2) in vec4 aColor; // Po instanci: boja
+
+uniform vec2 uRes;       // Rezolucija ekrana
+
+out vec4 vColor;
+
+void main()
+{
+    // Skaliranje i translacija jedinicnog kvadrata u pravougaonik instance
+    vec2 pos = aPos * aRect.zw + aRect.xy;
+
+    // Konverzija iz (0..Width, 0..Height) u (-1..1, -1..1), y=0 je dole
+    vec2 ndc = (pos / uRes) * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, ndc.y, 0.0, 1.0);
+    vColor = aColor;
+}
@@ -0,0 +1,16 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 vUV;
+in float vPxRange;
+
+uniform sampler2D uAtlas; // Udaljenost do poteza u kanalu R (StrokeFont.h), 0.5 = ivica poteza
+uniform vec4 uColor;
+
+void main()
+{
+    // Udaljenost od ivice u pikselima ekrana; pola piksela sa svake strane je prelaz
+    float dist = vPxRange * (texture(uAtlas, vUV).r - 0.5);
+    float alpha = clamp(dist + 0.5, 0.0, 1.0);
+    FragColor = vec4(uColor.rgb, uColor.a * alpha);
+}
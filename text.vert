@@ -0,0 +1,19 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;      // Jedinicni kvadrat (0..1)
+layout (location = 1) in vec4 aRect;     // Po znaku: x, y, width, height celije na ekranu
+layout (location = 2) in vec4 aUV;       // Po znaku: u0, v0, u1, v1 celije u atlasu
+layout (location = 3) in float aPxRange; // Po znaku: opseg udaljenosti u pikselima ekrana
+
+uniform vec2 uRes;       // Rezolucija ekrana
+
+out vec2 vUV;
+out float vPxRange;
+
+void main()
+{
+    vec2 pos = aPos * aRect.zw + aRect.xy;
+    vec2 ndc = (pos / uRes) * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, ndc.y, 0.0, 1.0);
+    vUV = mix(aUV.xy, aUV.zw, aPos);
+    vPxRange = aPxRange;
+}